@@ -0,0 +1,72 @@
+// Native-side WuiArray storage. See include/waterui_array.h.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "waterui_array.h"
+
+// Elements follow the header, aligned for any element type.
+typedef union InlineHeader {
+  uintptr_t len;
+  max_align_t align;
+} InlineHeader;
+
+static union InlineHeader empty_block;
+
+static void *inline_elements(const void *data) {
+  return (char *)data + sizeof(InlineHeader);
+}
+
+static struct WuiArraySlice inline_slice(const void *data) {
+  struct WuiArraySlice slice;
+  slice.len = ((const InlineHeader *)data)->len;
+  slice.head = slice.len > 0 ? inline_elements(data) : NULL;
+  return slice;
+}
+
+static void inline_drop(void *data) {
+  if (data != &empty_block) {
+    free(data);
+  }
+}
+
+struct WuiArray waterui_array_copy(const void *elements, uintptr_t len, uintptr_t element_size) {
+  struct WuiArray array;
+  array.vtable.drop = inline_drop;
+  array.vtable.slice = inline_slice;
+  if (len == 0) {
+    array.data = &empty_block;
+    return array;
+  }
+  // Zero-sized elements still need a block to carry their count.
+  if (element_size > 0 && len > (SIZE_MAX - sizeof(InlineHeader)) / element_size) {
+    abort();
+  }
+  InlineHeader *block = malloc(sizeof(InlineHeader) + len * element_size);
+  if (block == NULL) {
+    abort();
+  }
+  block->len = len;
+  if (element_size > 0) {
+    memcpy(inline_elements(block), elements, len * element_size);
+  }
+  array.data = block;
+  return array;
+}
+
+uintptr_t waterui_array_copy_alignment(void) {
+  return _Alignof(InlineHeader);
+}
+
+bool waterui_array_is_inline(const struct WuiArray *array) {
+  return array->vtable.slice == inline_slice;
+}
+
+struct WuiArraySlice waterui_array_slice(const struct WuiArray *array) {
+  // A direct call the compiler can inline, instead of an indirect one through the vtable.
+  if (array->vtable.slice == inline_slice) {
+    return inline_slice(array->data);
+  }
+  return array->vtable.slice(array->data);
+}
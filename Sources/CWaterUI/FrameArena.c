@@ -0,0 +1,149 @@
+// Per-thread bump allocator for transient buffers. See include/waterui_arena.h.
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "waterui_arena.h"
+
+#define WUI_ARENA_FIRST_BLOCK (64 * 1024)
+
+typedef struct ArenaBlock {
+  struct ArenaBlock *next;
+  uintptr_t size;
+  uintptr_t used;
+  // Keeps the first byte of `bytes` aligned for any type.
+  max_align_t align;
+  unsigned char bytes[];
+} ArenaBlock;
+
+typedef struct FrameArena {
+  ArenaBlock *first;
+  ArenaBlock *current;
+  uint32_t depth;
+} FrameArena;
+
+// Each thread's state lives on the heap behind a pthread key rather than in thread-local
+// storage: the key's destructor frees it when the thread exits, and the runtime clears
+// the key first, so nothing can reach the freed state afterwards.
+static pthread_key_t arena_key;
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+static bool arena_key_ready;
+
+static void arena_free(void *value) {
+  FrameArena *state = value;
+  for (ArenaBlock *block = state->first; block != NULL;) {
+    ArenaBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+  free(state);
+}
+
+static void arena_key_create(void) {
+  arena_key_ready = pthread_key_create(&arena_key, arena_free) == 0;
+}
+
+static FrameArena *current_arena(void) {
+  pthread_once(&arena_key_once, arena_key_create);
+  return arena_key_ready ? pthread_getspecific(arena_key) : NULL;
+}
+
+// Returns the calling thread's arena, creating it on first use, or NULL if it cannot be
+// set up.
+static FrameArena *thread_arena(void) {
+  FrameArena *state = current_arena();
+  if (state == NULL && arena_key_ready) {
+    state = calloc(1, sizeof(FrameArena));
+    if (state != NULL && pthread_setspecific(arena_key, state) != 0) {
+      free(state);
+      state = NULL;
+    }
+  }
+  return state;
+}
+
+static ArenaBlock *block_new(uintptr_t size) {
+  ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+  if (block != NULL) {
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+  }
+  return block;
+}
+
+// Returns the offset in `block` at which `size` bytes aligned to `align` fit, or
+// UINTPTR_MAX.
+static uintptr_t fit(const ArenaBlock *block, uintptr_t size, uintptr_t align) {
+  uintptr_t base = (uintptr_t)block->bytes;
+  uintptr_t offset = ((base + block->used + align - 1) & ~(align - 1)) - base;
+  if (offset > block->size || block->size - offset < size) {
+    return UINTPTR_MAX;
+  }
+  return offset;
+}
+
+void waterui_frame_arena_begin(void) {
+  FrameArena *state = thread_arena();
+  if (state != NULL) {
+    state->depth++;
+  }
+}
+
+void waterui_frame_arena_end(void) {
+  FrameArena *state = current_arena();
+  if (state == NULL || state->depth == 0 || --state->depth > 0) {
+    return;
+  }
+  ArenaBlock *first = state->first;
+  if (first != NULL && first->next != NULL) {
+    // The frame overflowed; replace the chain with one block that holds all of it.
+    uintptr_t total = 0;
+    for (ArenaBlock *block = first; block != NULL;) {
+      ArenaBlock *next = block->next;
+      total += block->size;
+      free(block);
+      block = next;
+    }
+    first = block_new(total);
+    state->first = first;
+  }
+  if (first != NULL) {
+    first->used = 0;
+  }
+  state->current = first;
+}
+
+void *waterui_frame_arena_alloc(uintptr_t size, uintptr_t align) {
+  FrameArena *state = current_arena();
+  if (state == NULL || state->depth == 0 || align == 0 || (align & (align - 1)) != 0) {
+    return NULL;
+  }
+  ArenaBlock *block = state->current;
+  uintptr_t offset = block != NULL ? fit(block, size, align) : UINTPTR_MAX;
+  if (offset == UINTPTR_MAX) {
+    if (size > UINTPTR_MAX / 2 - align) {
+      return NULL;
+    }
+    uintptr_t want = block != NULL ? block->size * 2 : WUI_ARENA_FIRST_BLOCK;
+    if (want < size + align) {
+      want = size + align;
+    }
+    ArenaBlock *grown = block_new(want);
+    if (grown == NULL) {
+      return NULL;
+    }
+    if (block != NULL) {
+      block->next = grown;
+    } else {
+      state->first = grown;
+    }
+    state->current = grown;
+    block = grown;
+    offset = fit(block, size, align);
+  }
+  block->used = offset + size;
+  return block->bytes + offset;
+}
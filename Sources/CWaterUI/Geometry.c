@@ -0,0 +1,122 @@
+// Geometry kernels. See include/waterui_geometry.h.
+
+#include <math.h>
+
+#include "waterui_geometry.h"
+
+// Define WUI_SNAP_SCALAR to build the portable path on any target, for testing it.
+#if defined(WUI_SNAP_SCALAR)
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WUI_SNAP_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define WUI_SNAP_NEON 1
+#endif
+
+// The vector paths snap one rect per iteration, with the x and y axes in the two double
+// lanes; they save the four scalar roundings, not work across rects.
+//
+// Snapped edges are rounded through 32-bit integers on the vector paths; anything beyond
+// this many pixels is left unsnapped.
+#define WUI_SNAP_LIMIT 1073741824.0
+
+static void widen(const struct WuiRect *rect, struct WuiRect64 *out) {
+  out->x = rect->origin.x;
+  out->y = rect->origin.y;
+  out->width = rect->size.width;
+  out->height = rect->size.height;
+}
+
+#if WUI_SNAP_SSE2
+
+static void snap_all(const struct WuiRect *rects, uintptr_t len, double scale, struct WuiRect64 *out) {
+  const __m128d factor = _mm_set1_pd(scale);
+  const __m128d limit = _mm_set1_pd(WUI_SNAP_LIMIT);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  for (uintptr_t i = 0; i < len; i++) {
+    __m128 rect = _mm_loadu_ps(&rects[i].origin.x);
+    // Widen before adding and scaling so large coordinates keep their precision.
+    // `origin` holds the near edges, `far` the far edges, of both axes.
+    __m128d origin = _mm_cvtps_pd(rect);
+    __m128d far = _mm_add_pd(origin, _mm_cvtps_pd(_mm_movehl_ps(rect, rect)));
+    __m128d lo = _mm_mul_pd(origin, factor);
+    __m128d hi = _mm_mul_pd(far, factor);
+    __m128d in_range = _mm_and_pd(_mm_cmplt_pd(_mm_andnot_pd(sign, lo), limit),
+                                  _mm_cmplt_pd(_mm_andnot_pd(sign, hi), limit));
+    if (_mm_movemask_pd(in_range) != 3) {
+      widen(&rects[i], &out[i]);
+      continue;
+    }
+    // Conversion rounds with the current mode, which is to nearest even by default.
+    lo = _mm_div_pd(_mm_cvtepi32_pd(_mm_cvtpd_epi32(lo)), factor);
+    hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_cvtpd_epi32(hi)), factor);
+    _mm_storeu_pd(&out[i].x, lo);
+    _mm_storeu_pd(&out[i].width, _mm_sub_pd(hi, lo));
+  }
+}
+
+#elif WUI_SNAP_NEON
+
+static void snap_all(const struct WuiRect *rects, uintptr_t len, double scale, struct WuiRect64 *out) {
+  const float64x2_t factor = vdupq_n_f64(scale);
+  const float64x2_t limit = vdupq_n_f64(WUI_SNAP_LIMIT);
+  for (uintptr_t i = 0; i < len; i++) {
+    float32x4_t rect = vld1q_f32(&rects[i].origin.x);
+    // Widen before adding and scaling so large coordinates keep their precision.
+    // `origin` holds the near edges, `far` the far edges, of both axes.
+    float64x2_t origin = vcvt_f64_f32(vget_low_f32(rect));
+    float64x2_t far = vaddq_f64(origin, vcvt_high_f64_f32(rect));
+    float64x2_t lo = vmulq_f64(origin, factor);
+    float64x2_t hi = vmulq_f64(far, factor);
+    uint64x2_t in_range = vandq_u64(vcaltq_f64(lo, limit), vcaltq_f64(hi, limit));
+    if ((vgetq_lane_u64(in_range, 0) & vgetq_lane_u64(in_range, 1)) == 0) {
+      widen(&rects[i], &out[i]);
+      continue;
+    }
+    lo = vdivq_f64(vrndnq_f64(lo), factor);
+    hi = vdivq_f64(vrndnq_f64(hi), factor);
+    vst1q_f64(&out[i].x, lo);
+    vst1q_f64(&out[i].width, vsubq_f64(hi, lo));
+  }
+}
+
+#else
+
+static void snap_scalar(const struct WuiRect *rect, double scale, struct WuiRect64 *out) {
+  double x0 = (double)rect->origin.x * scale;
+  double y0 = (double)rect->origin.y * scale;
+  double x1 = ((double)rect->origin.x + rect->size.width) * scale;
+  double y1 = ((double)rect->origin.y + rect->size.height) * scale;
+  if (!(fabs(x0) < WUI_SNAP_LIMIT && fabs(y0) < WUI_SNAP_LIMIT && fabs(x1) < WUI_SNAP_LIMIT &&
+        fabs(y1) < WUI_SNAP_LIMIT)) {
+    widen(rect, out);
+    return;
+  }
+  x0 = nearbyint(x0) / scale;
+  y0 = nearbyint(y0) / scale;
+  x1 = nearbyint(x1) / scale;
+  y1 = nearbyint(y1) / scale;
+  out->x = x0;
+  out->y = y0;
+  out->width = x1 - x0;
+  out->height = y1 - y0;
+}
+
+static void snap_all(const struct WuiRect *rects, uintptr_t len, double scale, struct WuiRect64 *out) {
+  for (uintptr_t i = 0; i < len; i++) {
+    snap_scalar(&rects[i], scale, &out[i]);
+  }
+}
+
+#endif
+
+void waterui_rects_snap(const struct WuiRect *rects, uintptr_t len, double scale, struct WuiRect64 *out) {
+  if (!(scale > 0)) {
+    for (uintptr_t i = 0; i < len; i++) {
+      widen(&rects[i], &out[i]);
+    }
+    return;
+  }
+  snap_all(rects, len, scale, out);
+}
@@ -0,0 +1,146 @@
+// Process-wide string intern table. See include/waterui_str.h.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "waterui_str.h"
+
+#define WUI_INTERN_INITIAL_BUCKETS 64
+
+typedef struct InternEntry {
+  struct InternEntry *next;
+  uint64_t hash;
+  uint64_t id;
+  // Guarded by the table lock, like the chains.
+  uint32_t refs;
+  uintptr_t len;
+  uint8_t bytes[];
+} InternEntry;
+
+static struct {
+  pthread_mutex_t lock;
+  InternEntry **buckets;
+  uintptr_t bucket_count;
+  uintptr_t count;
+  uint64_t last_id;
+} table = {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, 0};
+
+// Word-at-a-time multiplicative hash; labels are short, so speed matters more than quality
+// and the chains absorb the odd collision.
+static uint64_t hash_bytes(const uint8_t *bytes, uintptr_t len) {
+  uint64_t hash = 0x9E3779B97F4A7C15ull ^ len;
+  uint64_t word;
+  for (; len >= 8; bytes += 8, len -= 8) {
+    memcpy(&word, bytes, 8);
+    hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 32;
+  }
+  word = 0;
+  memcpy(&word, bytes, len);
+  hash = (hash ^ word) * 0xC4CEB9FE1A85EC53ull;
+  return hash ^ (hash >> 29);
+}
+
+static struct WuiArraySlice_u8 intern_slice(const void *data) {
+  const InternEntry *entry = data;
+  struct WuiArraySlice_u8 slice;
+  slice.head = (uint8_t *)entry->bytes;
+  slice.len = entry->len;
+  return slice;
+}
+
+static void intern_drop(void *data) {
+  InternEntry *entry = data;
+  pthread_mutex_lock(&table.lock);
+  if (--entry->refs == 0) {
+    InternEntry **link = &table.buckets[entry->hash & (table.bucket_count - 1)];
+    while (*link != entry) {
+      link = &(*link)->next;
+    }
+    *link = entry->next;
+    table.count--;
+    free(entry);
+  }
+  pthread_mutex_unlock(&table.lock);
+}
+
+static struct WuiStr handle(InternEntry *entry) {
+  struct WuiStr str;
+  str._0.data = entry;
+  str._0.vtable.drop = intern_drop;
+  str._0.vtable.slice = intern_slice;
+  return str;
+}
+
+// Doubles the bucket array. Must be called with the lock held.
+static bool grow(void) {
+  uintptr_t bucket_count = table.bucket_count > 0 ? table.bucket_count * 2 : WUI_INTERN_INITIAL_BUCKETS;
+  InternEntry **buckets = calloc(bucket_count, sizeof(InternEntry *));
+  if (buckets == NULL) {
+    return false;
+  }
+  for (uintptr_t i = 0; i < table.bucket_count; i++) {
+    InternEntry *entry = table.buckets[i];
+    while (entry != NULL) {
+      InternEntry *next = entry->next;
+      InternEntry **bucket = &buckets[entry->hash & (bucket_count - 1)];
+      entry->next = *bucket;
+      *bucket = entry;
+      entry = next;
+    }
+  }
+  free(table.buckets);
+  table.buckets = buckets;
+  table.bucket_count = bucket_count;
+  return true;
+}
+
+struct WuiStr waterui_str_intern(const uint8_t *bytes, uintptr_t len) {
+  if (len == 0) {
+    bytes = (const uint8_t *)"";
+  }
+  uint64_t hash = hash_bytes(bytes, len);
+  pthread_mutex_lock(&table.lock);
+  if (table.count >= table.bucket_count && !grow() && table.bucket_count == 0) {
+    pthread_mutex_unlock(&table.lock);
+    abort();
+  }
+  InternEntry **bucket = &table.buckets[hash & (table.bucket_count - 1)];
+  for (InternEntry *entry = *bucket; entry != NULL; entry = entry->next) {
+    if (entry->hash == hash && entry->len == len && memcmp(entry->bytes, bytes, len) == 0) {
+      entry->refs++;
+      pthread_mutex_unlock(&table.lock);
+      return handle(entry);
+    }
+  }
+  InternEntry *entry = malloc(sizeof(InternEntry) + len);
+  if (entry == NULL) {
+    pthread_mutex_unlock(&table.lock);
+    abort();
+  }
+  memcpy(entry->bytes, bytes, len);
+  entry->hash = hash;
+  entry->id = ++table.last_id;
+  entry->refs = 1;
+  entry->len = len;
+  entry->next = *bucket;
+  *bucket = entry;
+  table.count++;
+  pthread_mutex_unlock(&table.lock);
+  return handle(entry);
+}
+
+uint64_t waterui_str_intern_id(const struct WuiStr *str) {
+  if (str->_0.vtable.slice != intern_slice) {
+    return 0;
+  }
+  return ((const InternEntry *)str->_0.data)->id;
+}
+
+uintptr_t waterui_str_intern_count(void) {
+  pthread_mutex_lock(&table.lock);
+  uintptr_t count = table.count;
+  pthread_mutex_unlock(&table.lock);
+  return count;
+}
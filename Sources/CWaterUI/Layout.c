@@ -0,0 +1,86 @@
+// Native-side layout driver. See include/waterui_layout.h.
+
+#include <string.h>
+
+#include "LayoutStatsRecorder.h"
+#include "LayoutTraceRecorder.h"
+#include "waterui_layout.h"
+
+// Every Rust layout call goes through these two functions so that recording and the
+// cost counters see the whole negotiation.
+
+static struct WuiSize drive_size_that_fits(struct WuiLayout *layout,
+                                           struct WuiProposalSize proposal,
+                                           struct WuiSubViews *subviews) {
+  // Rust measures children one by one on this thread; warm the thread-safe ones in
+  // parallel first so those calls are answered from the caches.
+  waterui_subviews_prefetch(subviews, proposal);
+  struct WuiArray_WuiSubView children = waterui_subviews_array(subviews);
+  struct WuiTraceCall *trace = wui_trace_begin_size(layout, proposal, &children);
+  wui_stats_begin_call(false);
+  struct WuiSize size = waterui_layout_size_that_fits(layout, proposal, children);
+  wui_stats_end_call();
+  wui_trace_end_size(trace, size);
+  return size;
+}
+
+static struct WuiArray_WuiRect drive_place(struct WuiLayout *layout,
+                                           struct WuiRect bounds,
+                                           struct WuiSubViews *subviews) {
+  struct WuiArray_WuiSubView children = waterui_subviews_array(subviews);
+  struct WuiTraceCall *trace = wui_trace_begin_place(layout, bounds, &children);
+  wui_stats_begin_call(true);
+  struct WuiArray_WuiRect rects = waterui_layout_place(layout, bounds, children);
+  wui_stats_end_call();
+  wui_stats_allocation();
+  wui_trace_end_place(trace, rects);
+  return rects;
+}
+
+struct WuiSize waterui_layout_container_size(struct WuiLayout *layout,
+                                             struct WuiProposalSize proposal,
+                                             struct WuiSubViews *subviews) {
+  return drive_size_that_fits(layout, proposal, subviews);
+}
+
+struct WuiSize waterui_layout_size_and_place(struct WuiLayout *layout,
+                                             struct WuiProposalSize proposal,
+                                             struct WuiRect bounds,
+                                             struct WuiSubViews *subviews,
+                                             struct WuiArray_WuiRect *out_rects) {
+  // The set hands out borrowed arrays, so it can back both Rust calls.
+  wui_stats_begin_pass();
+  struct WuiSize size = drive_size_that_fits(layout, proposal, subviews);
+  *out_rects = drive_place(layout, bounds, subviews);
+  wui_stats_end_pass();
+  return size;
+}
+
+uintptr_t waterui_layout_place_into(struct WuiLayout *layout,
+                                    struct WuiRect bounds,
+                                    struct WuiSubViews *subviews,
+                                    struct WuiRect *out_rects,
+                                    uintptr_t capacity) {
+  struct WuiArray_WuiRect rects = drive_place(layout, bounds, subviews);
+  struct WuiArraySlice_WuiRect slice = rects.vtable.slice(rects.data);
+  uintptr_t count = slice.len < capacity ? slice.len : capacity;
+  if (count > 0) {
+    memcpy(out_rects, slice.head, count * sizeof(struct WuiRect));
+  }
+  rects.vtable.drop(rects.data);
+  return slice.len;
+}
+
+struct WuiSize waterui_layout_size_and_place_into(struct WuiLayout *layout,
+                                                  struct WuiProposalSize proposal,
+                                                  struct WuiRect bounds,
+                                                  struct WuiSubViews *subviews,
+                                                  struct WuiRect *out_rects,
+                                                  uintptr_t capacity,
+                                                  uintptr_t *out_len) {
+  wui_stats_begin_pass();
+  struct WuiSize size = drive_size_that_fits(layout, proposal, subviews);
+  *out_len = waterui_layout_place_into(layout, bounds, subviews, out_rects, capacity);
+  wui_stats_end_pass();
+  return size;
+}
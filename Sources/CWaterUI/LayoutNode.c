@@ -0,0 +1,132 @@
+// Native mirror of the container hierarchy with dirty tracking. See include/waterui_layout.h.
+
+#include <string.h>
+
+#include "waterui_layout.h"
+
+enum {
+  WUI_LAYOUT_NODE_DIRTY = 1 << 0,
+  WUI_LAYOUT_NODE_DESCENDANT_DIRTY = 1 << 1,
+  WUI_LAYOUT_NODE_HAS_BOUNDS = 1 << 2,
+};
+
+// Siblings form an intrusive doubly linked list so attach and detach are O(1).
+struct WuiLayoutNode {
+  struct WuiLayoutNode *parent;
+  struct WuiLayoutNode *first_child;
+  struct WuiLayoutNode *prev_sibling;
+  struct WuiLayoutNode *next_sibling;
+  struct WuiRect bounds;
+  // Pixels per point the placement was snapped at.
+  float scale;
+  uint32_t flags;
+};
+
+struct WuiLayoutNode *waterui_layout_node_new(void) {
+  struct WuiLayoutNode *node = calloc(1, sizeof(struct WuiLayoutNode));
+  if (node != NULL) {
+    node->flags = WUI_LAYOUT_NODE_DIRTY;
+  }
+  return node;
+}
+
+static void detach(struct WuiLayoutNode *node) {
+  if (node->parent == NULL) {
+    return;
+  }
+  if (node->prev_sibling != NULL) {
+    node->prev_sibling->next_sibling = node->next_sibling;
+  } else {
+    node->parent->first_child = node->next_sibling;
+  }
+  if (node->next_sibling != NULL) {
+    node->next_sibling->prev_sibling = node->prev_sibling;
+  }
+  node->parent = NULL;
+  node->prev_sibling = NULL;
+  node->next_sibling = NULL;
+}
+
+void waterui_layout_node_drop(struct WuiLayoutNode *node) {
+  if (node == NULL) {
+    return;
+  }
+  detach(node);
+  struct WuiLayoutNode *child = node->first_child;
+  while (child != NULL) {
+    struct WuiLayoutNode *next = child->next_sibling;
+    child->parent = NULL;
+    child->prev_sibling = NULL;
+    child->next_sibling = NULL;
+    child = next;
+  }
+  free(node);
+}
+
+static void flag_ancestors(struct WuiLayoutNode *node) {
+  // Ancestors clear their flags independently as they lay out, so a flagged node does
+  // not imply a flagged parent; walk the whole chain.
+  for (struct WuiLayoutNode *p = node->parent; p != NULL; p = p->parent) {
+    p->flags |= WUI_LAYOUT_NODE_DESCENDANT_DIRTY;
+  }
+}
+
+void waterui_layout_node_set_parent(struct WuiLayoutNode *node, struct WuiLayoutNode *parent) {
+  if (node->parent == parent) {
+    return;
+  }
+  detach(node);
+  if (parent == NULL) {
+    return;
+  }
+  node->parent = parent;
+  node->next_sibling = parent->first_child;
+  if (parent->first_child != NULL) {
+    parent->first_child->prev_sibling = node;
+  }
+  parent->first_child = node;
+  if (node->flags & (WUI_LAYOUT_NODE_DIRTY | WUI_LAYOUT_NODE_DESCENDANT_DIRTY)) {
+    flag_ancestors(node);
+  }
+}
+
+struct WuiLayoutNode *waterui_layout_node_parent(const struct WuiLayoutNode *node) {
+  return node->parent;
+}
+
+void waterui_layout_node_mark_dirty(struct WuiLayoutNode *node) {
+  node->flags |= WUI_LAYOUT_NODE_DIRTY;
+  flag_ancestors(node);
+}
+
+bool waterui_layout_node_child_changed(struct WuiLayoutNode *node, struct WuiMeasureCache *child_cache) {
+  if (child_cache != NULL && !waterui_measure_cache_revalidate(child_cache)) {
+    return false;
+  }
+  waterui_layout_node_mark_dirty(node);
+  return true;
+}
+
+bool waterui_layout_node_is_dirty(const struct WuiLayoutNode *node) {
+  return (node->flags & WUI_LAYOUT_NODE_DIRTY) != 0;
+}
+
+bool waterui_layout_node_has_dirty_descendant(const struct WuiLayoutNode *node) {
+  return (node->flags & WUI_LAYOUT_NODE_DESCENDANT_DIRTY) != 0;
+}
+
+bool waterui_layout_node_needs_layout(const struct WuiLayoutNode *node, struct WuiRect bounds, float scale) {
+  if (node->flags & WUI_LAYOUT_NODE_DIRTY) {
+    return true;
+  }
+  if (!(node->flags & WUI_LAYOUT_NODE_HAS_BOUNDS)) {
+    return true;
+  }
+  return node->scale != scale || memcmp(&node->bounds, &bounds, sizeof(bounds)) != 0;
+}
+
+void waterui_layout_node_did_layout(struct WuiLayoutNode *node, struct WuiRect bounds, float scale) {
+  node->bounds = bounds;
+  node->scale = scale;
+  node->flags = WUI_LAYOUT_NODE_HAS_BOUNDS;
+}
@@ -0,0 +1,202 @@
+// Layout cost counters. See include/waterui_layout.h.
+
+#if !defined(__APPLE__) && !defined(_POSIX_C_SOURCE)
+// clock_gettime and CLOCK_MONOTONIC are POSIX, not C11.
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#endif
+
+#include "LayoutStatsRecorder.h"
+
+uint64_t wui_now_ns(void) {
+#if defined(__APPLE__)
+  static mach_timebase_info_data_t timebase;
+  if (timebase.denom == 0) {
+    // Racing initializers store the same value.
+    mach_timebase_info(&timebase);
+  }
+  return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Time is charged exclusively: each nanosecond goes to whichever side is running, so a
+// nested container's Rust call made from inside a measure callback counts as Rust time,
+// not as native measure time.
+enum {
+  WUI_STATS_IDLE,
+  WUI_STATS_RUST,
+  WUI_STATS_NATIVE,
+};
+
+// Deeper nesting is still counted, but its time is charged to the innermost tracked side.
+#define WUI_STATS_MAX_TRACKED_DEPTH 64
+
+// The counters are shared by every thread that lays out or allocates for layout.
+static struct {
+  atomic_uint_least64_t passes;
+  atomic_uint_least64_t size_calls;
+  atomic_uint_least64_t place_calls;
+  atomic_uint_least64_t measure_callbacks;
+  atomic_uint_least64_t last_pass_measure_callbacks;
+  atomic_uint_least64_t max_pass_measure_callbacks;
+  atomic_uint_least32_t max_depth;
+  atomic_uint_least64_t rust_ns;
+  atomic_uint_least64_t native_measure_ns;
+  atomic_uint_least64_t allocations;
+} stats;
+
+// The nesting state of a pass belongs to the thread running it.
+typedef struct PassState {
+  uint8_t sides[WUI_STATS_MAX_TRACKED_DEPTH];
+  uint32_t side_depth;
+  // Open pass brackets, including the layout calls, which each open one.
+  uint32_t open;
+  uint32_t call_depth;
+  uint64_t segment_start;
+  uint64_t measures;
+} PassState;
+
+static _Thread_local PassState pass;
+
+static void add(atomic_uint_least64_t *counter, uint64_t value) {
+  atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static void raise_to(atomic_uint_least64_t *counter, uint64_t value) {
+  uint64_t seen = atomic_load_explicit(counter, memory_order_relaxed);
+  while (seen < value &&
+         !atomic_compare_exchange_weak_explicit(counter, &seen, value, memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+static void raise_to_32(atomic_uint_least32_t *counter, uint32_t value) {
+  uint32_t seen = atomic_load_explicit(counter, memory_order_relaxed);
+  while (seen < value &&
+         !atomic_compare_exchange_weak_explicit(counter, &seen, value, memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+static uint8_t current_side(void) {
+  if (pass.side_depth == 0) {
+    return WUI_STATS_IDLE;
+  }
+  uint32_t top = pass.side_depth <= WUI_STATS_MAX_TRACKED_DEPTH ? pass.side_depth : WUI_STATS_MAX_TRACKED_DEPTH;
+  return pass.sides[top - 1];
+}
+
+static void charge(uint64_t now) {
+  switch (current_side()) {
+  case WUI_STATS_RUST:
+    add(&stats.rust_ns, now - pass.segment_start);
+    break;
+  case WUI_STATS_NATIVE:
+    add(&stats.native_measure_ns, now - pass.segment_start);
+    break;
+  default:
+    break;
+  }
+  pass.segment_start = now;
+}
+
+static void push_side(uint8_t side) {
+  charge(wui_now_ns());
+  if (pass.side_depth < WUI_STATS_MAX_TRACKED_DEPTH) {
+    pass.sides[pass.side_depth] = side;
+  }
+  pass.side_depth++;
+}
+
+static void pop_side(void) {
+  charge(wui_now_ns());
+  pass.side_depth--;
+}
+
+void wui_stats_begin_pass(void) {
+  if (pass.open == 0) {
+    add(&stats.passes, 1);
+    pass.measures = 0;
+  }
+  pass.open++;
+}
+
+void wui_stats_end_pass(void) {
+  pass.open--;
+  if (pass.open == 0) {
+    atomic_store_explicit(&stats.last_pass_measure_callbacks, pass.measures, memory_order_relaxed);
+    raise_to(&stats.max_pass_measure_callbacks, pass.measures);
+  }
+}
+
+void wui_stats_begin_call(bool place) {
+  wui_stats_begin_pass();
+  pass.call_depth++;
+  raise_to_32(&stats.max_depth, pass.call_depth);
+  add(place ? &stats.place_calls : &stats.size_calls, 1);
+  push_side(WUI_STATS_RUST);
+}
+
+void wui_stats_end_call(void) {
+  pop_side();
+  pass.call_depth--;
+  wui_stats_end_pass();
+}
+
+void wui_stats_begin_measure(void) {
+  if (pass.call_depth == 0) {
+    return;
+  }
+  add(&stats.measure_callbacks, 1);
+  pass.measures++;
+  push_side(WUI_STATS_NATIVE);
+}
+
+void wui_stats_end_measure(void) {
+  if (pass.call_depth == 0) {
+    return;
+  }
+  pop_side();
+}
+
+void wui_stats_allocation(void) {
+  add(&stats.allocations, 1);
+}
+
+struct WuiLayoutStats waterui_layout_stats(void) {
+  struct WuiLayoutStats out;
+  memset(&out, 0, sizeof(out));
+  out.passes = atomic_load_explicit(&stats.passes, memory_order_relaxed);
+  out.size_calls = atomic_load_explicit(&stats.size_calls, memory_order_relaxed);
+  out.place_calls = atomic_load_explicit(&stats.place_calls, memory_order_relaxed);
+  out.measure_callbacks = atomic_load_explicit(&stats.measure_callbacks, memory_order_relaxed);
+  out.last_pass_measure_callbacks = atomic_load_explicit(&stats.last_pass_measure_callbacks, memory_order_relaxed);
+  out.max_pass_measure_callbacks = atomic_load_explicit(&stats.max_pass_measure_callbacks, memory_order_relaxed);
+  out.max_depth = atomic_load_explicit(&stats.max_depth, memory_order_relaxed);
+  out.rust_ns = atomic_load_explicit(&stats.rust_ns, memory_order_relaxed);
+  out.native_measure_ns = atomic_load_explicit(&stats.native_measure_ns, memory_order_relaxed);
+  out.allocations = atomic_load_explicit(&stats.allocations, memory_order_relaxed);
+  return out;
+}
+
+void waterui_layout_stats_reset(void) {
+  atomic_store_explicit(&stats.passes, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.size_calls, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.place_calls, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.measure_callbacks, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.last_pass_measure_callbacks, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.max_pass_measure_callbacks, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.max_depth, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.rust_ns, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.native_measure_ns, 0, memory_order_relaxed);
+  atomic_store_explicit(&stats.allocations, 0, memory_order_relaxed);
+}
@@ -0,0 +1,42 @@
+// Counter hooks used by the layout driver. Not part of the public headers.
+
+#ifndef WATERUI_LAYOUT_STATS_RECORDER_H
+#define WATERUI_LAYOUT_STATS_RECORDER_H
+
+#include "waterui_layout.h"
+
+/**
+ * Monotonic nanoseconds, for measuring intervals.
+ */
+uint64_t wui_now_ns(void);
+
+/**
+ * Brackets one layout pass made of several calls, such as sizing and then placing, so
+ * they count as a single pass. Calls made outside a bracket each open their own.
+ */
+void wui_stats_begin_pass(void);
+
+void wui_stats_end_pass(void);
+
+/**
+ * Brackets a call into a Rust layout. The outermost call opens a pass unless one is
+ * already open.
+ */
+void wui_stats_begin_call(bool place);
+
+void wui_stats_end_call(void);
+
+/**
+ * Brackets a measure callback made by a Rust layout. Callbacks made outside a layout
+ * call are ignored.
+ */
+void wui_stats_begin_measure(void);
+
+void wui_stats_end_measure(void);
+
+/**
+ * Counts one heap allocation made on behalf of layout.
+ */
+void wui_stats_allocation(void);
+
+#endif /* WATERUI_LAYOUT_STATS_RECORDER_H */
@@ -0,0 +1,199 @@
+// Layout trace recorder. See include/waterui_layout_trace.h.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "LayoutTraceRecorder.h"
+
+static FILE *trace_file;
+
+typedef struct TracedChild {
+  struct WuiSubView inner;
+  uint32_t index;
+} TracedChild;
+
+struct WuiTraceCall {
+  TracedChild *children;
+  struct WuiSubView *subviews;
+  uintptr_t len;
+};
+
+static void write_bytes(const void *bytes, size_t len) {
+  fwrite(bytes, 1, len, trace_file);
+}
+
+static void write_u8(uint8_t value) {
+  write_bytes(&value, sizeof(value));
+}
+
+static void write_u32(uint32_t value) {
+  write_bytes(&value, sizeof(value));
+}
+
+static void write_floats(const float *values, size_t count) {
+  write_bytes(values, count * sizeof(float));
+}
+
+bool waterui_layout_trace_start(const char *path) {
+  if (trace_file != NULL) {
+    return false;
+  }
+  trace_file = fopen(path, "wb");
+  if (trace_file == NULL) {
+    return false;
+  }
+  // Traces are written in bursts of small records; a large buffer keeps fwrite cheap.
+  setvbuf(trace_file, NULL, _IOFBF, 1 << 16);
+  uint16_t version = WUI_LAYOUT_TRACE_VERSION;
+  uint16_t byte_order = WUI_LAYOUT_TRACE_BYTE_ORDER_MARK;
+  write_bytes("WUIT", 4);
+  write_bytes(&version, sizeof(version));
+  write_bytes(&byte_order, sizeof(byte_order));
+  return true;
+}
+
+void waterui_layout_trace_stop(void) {
+  if (trace_file == NULL) {
+    return;
+  }
+  fclose(trace_file);
+  trace_file = NULL;
+}
+
+bool waterui_layout_trace_is_active(void) {
+  return trace_file != NULL;
+}
+
+static struct WuiSize traced_measure(void *context, struct WuiProposalSize proposal) {
+  TracedChild *child = context;
+  struct WuiSize size = child->inner.vtable.measure(child->inner.context, proposal);
+  if (trace_file != NULL) {
+    write_u8(WuiLayoutTraceTag_Measure);
+    write_u32(child->index);
+    write_floats(&proposal.width, 1);
+    write_floats(&proposal.height, 1);
+    write_floats(&size.width, 1);
+    write_floats(&size.height, 1);
+  }
+  return size;
+}
+
+static void traced_drop(void *context) {
+  (void)context;
+}
+
+static void traced_array_drop(void *data) {
+  (void)data;
+}
+
+static struct WuiArraySlice_WuiSubView traced_array_slice(const void *data) {
+  const struct WuiTraceCall *call = data;
+  struct WuiArraySlice_WuiSubView slice;
+  slice.head = call->subviews;
+  slice.len = call->len;
+  return slice;
+}
+
+static struct WuiTraceCall *begin_call(WuiLayoutTraceTag tag,
+                                       struct WuiLayout *layout,
+                                       const float *header,
+                                       size_t header_len,
+                                       struct WuiArray_WuiSubView *children) {
+  if (trace_file == NULL) {
+    return NULL;
+  }
+  struct WuiArraySlice_WuiSubView slice = children->vtable.slice(children->data);
+  struct WuiTraceCall *call = calloc(1, sizeof(struct WuiTraceCall));
+  if (call == NULL) {
+    return NULL;
+  }
+  call->len = slice.len;
+  if (slice.len > 0) {
+    call->children = calloc(slice.len, sizeof(TracedChild));
+    call->subviews = calloc(slice.len, sizeof(struct WuiSubView));
+    if (call->children == NULL || call->subviews == NULL) {
+      free(call->children);
+      free(call->subviews);
+      free(call);
+      return NULL;
+    }
+  }
+
+  uint64_t layout_id = (uint64_t)(uintptr_t)layout;
+  write_u8((uint8_t)tag);
+  write_bytes(&layout_id, sizeof(layout_id));
+  write_floats(header, header_len);
+  write_u32((uint32_t)slice.len);
+
+  for (uintptr_t i = 0; i < slice.len; i++) {
+    struct WuiSubView original = slice.head[i];
+    call->children[i].inner = original;
+    call->children[i].index = (uint32_t)i;
+
+    struct WuiSubView *traced = &call->subviews[i];
+    traced->context = &call->children[i];
+    traced->vtable.measure = traced_measure;
+    traced->vtable.drop = traced_drop;
+    traced->stretch_axis = original.stretch_axis;
+    traced->priority = original.priority;
+
+    write_u8((uint8_t)original.stretch_axis);
+    write_bytes(&original.priority, sizeof(original.priority));
+  }
+
+  // The traced array borrows the originals, so the caller's array is dropped as usual.
+  children->vtable.drop(children->data);
+  children->data = call;
+  children->vtable.drop = traced_array_drop;
+  children->vtable.slice = traced_array_slice;
+  return call;
+}
+
+struct WuiTraceCall *wui_trace_begin_size(struct WuiLayout *layout,
+                                          struct WuiProposalSize proposal,
+                                          struct WuiArray_WuiSubView *children) {
+  float header[2] = {proposal.width, proposal.height};
+  return begin_call(WuiLayoutTraceTag_SizeCall, layout, header, 2, children);
+}
+
+struct WuiTraceCall *wui_trace_begin_place(struct WuiLayout *layout,
+                                           struct WuiRect bounds,
+                                           struct WuiArray_WuiSubView *children) {
+  float header[4] = {bounds.origin.x, bounds.origin.y, bounds.size.width, bounds.size.height};
+  return begin_call(WuiLayoutTraceTag_PlaceCall, layout, header, 4, children);
+}
+
+static void free_call(struct WuiTraceCall *call) {
+  free(call->children);
+  free(call->subviews);
+  free(call);
+}
+
+void wui_trace_end_size(struct WuiTraceCall *call, struct WuiSize size) {
+  if (call == NULL) {
+    return;
+  }
+  if (trace_file != NULL) {
+    write_u8(WuiLayoutTraceTag_SizeResult);
+    write_floats(&size.width, 1);
+    write_floats(&size.height, 1);
+  }
+  free_call(call);
+}
+
+void wui_trace_end_place(struct WuiTraceCall *call, struct WuiArray_WuiRect rects) {
+  if (call == NULL) {
+    return;
+  }
+  if (trace_file != NULL) {
+    struct WuiArraySlice_WuiRect slice = rects.vtable.slice(rects.data);
+    write_u8(WuiLayoutTraceTag_PlaceResult);
+    write_u32((uint32_t)slice.len);
+    for (uintptr_t i = 0; i < slice.len; i++) {
+      struct WuiRect rect = slice.head[i];
+      float values[4] = {rect.origin.x, rect.origin.y, rect.size.width, rect.size.height};
+      write_floats(values, 4);
+    }
+  }
+  free_call(call);
+}
@@ -0,0 +1,26 @@
+// Recorder hooks used by the layout driver. Not part of the public headers.
+
+#ifndef WATERUI_LAYOUT_TRACE_RECORDER_H
+#define WATERUI_LAYOUT_TRACE_RECORDER_H
+
+#include "waterui_layout_trace.h"
+
+typedef struct WuiTraceCall WuiTraceCall;
+
+/**
+ * Opens a recorded call. `children` is replaced with an array whose measures are
+ * recorded; it stays valid until the matching end call.
+ */
+struct WuiTraceCall *wui_trace_begin_size(struct WuiLayout *layout,
+                                          struct WuiProposalSize proposal,
+                                          struct WuiArray_WuiSubView *children);
+
+struct WuiTraceCall *wui_trace_begin_place(struct WuiLayout *layout,
+                                           struct WuiRect bounds,
+                                           struct WuiArray_WuiSubView *children);
+
+void wui_trace_end_size(struct WuiTraceCall *call, struct WuiSize size);
+
+void wui_trace_end_place(struct WuiTraceCall *call, struct WuiArray_WuiRect rects);
+
+#endif /* WATERUI_LAYOUT_TRACE_RECORDER_H */
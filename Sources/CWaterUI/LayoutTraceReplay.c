@@ -0,0 +1,390 @@
+// Offline layout trace replay. See include/waterui_layout_trace.h.
+
+#include <string.h>
+
+#include "LayoutStatsRecorder.h"
+#include "ProposalKey.h"
+#include "waterui_layout_trace.h"
+
+typedef struct Reader {
+  const uint8_t *cursor;
+  const uint8_t *end;
+  bool ok;
+} Reader;
+
+static void read_bytes(Reader *reader, void *out, size_t len) {
+  if (!reader->ok || (size_t)(reader->end - reader->cursor) < len) {
+    reader->ok = false;
+    memset(out, 0, len);
+    return;
+  }
+  memcpy(out, reader->cursor, len);
+  reader->cursor += len;
+}
+
+static uint32_t read_u32(Reader *reader) {
+  uint32_t value;
+  read_bytes(reader, &value, sizeof(value));
+  return value;
+}
+
+static float read_f32(Reader *reader) {
+  float value;
+  read_bytes(reader, &value, sizeof(value));
+  return value;
+}
+
+typedef struct ReplayMeasure {
+  uint32_t index;
+  struct WuiProposalSize proposal;
+  struct WuiSize size;
+} ReplayMeasure;
+
+// Recorded measures ordered by child, then proposal, then recording position, so a
+// stand-in finds the first matching measure by binary search.
+typedef struct MeasureKey {
+  uint32_t index;
+  uint32_t position;
+  uint64_t proposal;
+} MeasureKey;
+
+typedef struct ReplayFrame ReplayFrame;
+
+typedef struct StandIn {
+  ReplayFrame *frame;
+  uint32_t index;
+} StandIn;
+
+struct ReplayFrame {
+  uint8_t tag;
+  uint64_t layout_id;
+  float header[4];
+  uint32_t len;
+  StandIn *stand_ins;
+  struct WuiSubView *subviews;
+  ReplayMeasure *measures;
+  size_t measure_len;
+  size_t measure_cap;
+  // Built on the first lookup, once every measure of the call has been read.
+  MeasureKey *keys;
+  struct WuiLayoutTraceReplayStats *stats;
+};
+
+static int compare_keys(const MeasureKey *a, const MeasureKey *b) {
+  if (a->index != b->index) {
+    return a->index < b->index ? -1 : 1;
+  }
+  if (a->proposal != b->proposal) {
+    return a->proposal < b->proposal ? -1 : 1;
+  }
+  if (a->position != b->position) {
+    return a->position < b->position ? -1 : 1;
+  }
+  return 0;
+}
+
+static int compare_keys_qsort(const void *a, const void *b) {
+  return compare_keys(a, b);
+}
+
+static bool build_keys(ReplayFrame *frame) {
+  frame->keys = malloc(frame->measure_len * sizeof(MeasureKey));
+  if (frame->keys == NULL) {
+    return false;
+  }
+  for (size_t i = 0; i < frame->measure_len; i++) {
+    frame->keys[i].index = frame->measures[i].index;
+    frame->keys[i].position = (uint32_t)i;
+    // NaN means "unspecified"; the key folds every NaN into one.
+    frame->keys[i].proposal = wui_proposal_key(frame->measures[i].proposal);
+  }
+  qsort(frame->keys, frame->measure_len, sizeof(MeasureKey), compare_keys_qsort);
+  return true;
+}
+
+static struct WuiSize stand_in_measure(void *context, struct WuiProposalSize proposal) {
+  StandIn *stand_in = context;
+  ReplayFrame *frame = stand_in->frame;
+  frame->stats->measures++;
+  if (frame->measure_len > 0 && (frame->keys != NULL || build_keys(frame))) {
+    // Lower bound of (index, proposal, 0) is the earliest recorded match, if any.
+    MeasureKey probe = {stand_in->index, 0, wui_proposal_key(proposal)};
+    size_t lo = 0;
+    size_t hi = frame->measure_len;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (compare_keys(&frame->keys[mid], &probe) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo < frame->measure_len && frame->keys[lo].index == probe.index &&
+        frame->keys[lo].proposal == probe.proposal) {
+      return frame->measures[frame->keys[lo].position].size;
+    }
+  }
+  frame->stats->unmatched_measures++;
+  struct WuiSize zero = {0, 0};
+  return zero;
+}
+
+static void stand_in_drop(void *context) {
+  (void)context;
+}
+
+static void frame_array_drop(void *data) {
+  (void)data;
+}
+
+static struct WuiArraySlice_WuiSubView frame_array_slice(const void *data) {
+  const ReplayFrame *frame = data;
+  struct WuiArraySlice_WuiSubView slice;
+  slice.head = frame->subviews;
+  slice.len = frame->len;
+  return slice;
+}
+
+static void free_frame(ReplayFrame *frame) {
+  if (frame == NULL) {
+    return;
+  }
+  free(frame->stand_ins);
+  free(frame->subviews);
+  free(frame->measures);
+  free(frame->keys);
+  free(frame);
+}
+
+static ReplayFrame *read_call(Reader *reader, uint8_t tag, struct WuiLayoutTraceReplayStats *stats) {
+  ReplayFrame *frame = calloc(1, sizeof(ReplayFrame));
+  if (frame == NULL) {
+    reader->ok = false;
+    return NULL;
+  }
+  frame->tag = tag;
+  frame->stats = stats;
+  read_bytes(reader, &frame->layout_id, sizeof(frame->layout_id));
+  size_t header_len = tag == WuiLayoutTraceTag_SizeCall ? 2 : 4;
+  for (size_t i = 0; i < header_len; i++) {
+    frame->header[i] = read_f32(reader);
+  }
+  frame->len = read_u32(reader);
+  // Each child takes 5 bytes; reject counts the remaining input cannot hold.
+  if (!reader->ok || frame->len > (size_t)(reader->end - reader->cursor) / 5) {
+    reader->ok = false;
+    free_frame(frame);
+    return NULL;
+  }
+
+  if (frame->len > 0) {
+    frame->stand_ins = calloc(frame->len, sizeof(StandIn));
+    frame->subviews = calloc(frame->len, sizeof(struct WuiSubView));
+    if (frame->stand_ins == NULL || frame->subviews == NULL) {
+      reader->ok = false;
+      free_frame(frame);
+      return NULL;
+    }
+  }
+  for (uint32_t i = 0; i < frame->len; i++) {
+    uint8_t axis;
+    int32_t priority;
+    read_bytes(reader, &axis, sizeof(axis));
+    read_bytes(reader, &priority, sizeof(priority));
+    frame->stand_ins[i].frame = frame;
+    frame->stand_ins[i].index = i;
+    frame->subviews[i].context = &frame->stand_ins[i];
+    frame->subviews[i].vtable.measure = stand_in_measure;
+    frame->subviews[i].vtable.drop = stand_in_drop;
+    frame->subviews[i].stretch_axis = (enum WuiStretchAxis)axis;
+    frame->subviews[i].priority = priority;
+  }
+  return frame;
+}
+
+static bool push_measure(ReplayFrame *frame, ReplayMeasure measure) {
+  if (frame->measure_len == frame->measure_cap) {
+    size_t cap = frame->measure_cap == 0 ? 8 : frame->measure_cap * 2;
+    ReplayMeasure *grown = realloc(frame->measures, cap * sizeof(ReplayMeasure));
+    if (grown == NULL) {
+      return false;
+    }
+    frame->measures = grown;
+    frame->measure_cap = cap;
+  }
+  frame->measures[frame->measure_len++] = measure;
+  return true;
+}
+
+static struct WuiArray_WuiSubView frame_array(ReplayFrame *frame) {
+  struct WuiArray_WuiSubView array;
+  array.data = frame;
+  array.vtable.drop = frame_array_drop;
+  array.vtable.slice = frame_array_slice;
+  return array;
+}
+
+// Re-issues the recorded measurement stream against the stand-ins.
+static void replay_measures(ReplayFrame *frame) {
+  for (size_t i = 0; i < frame->measure_len; i++) {
+    const ReplayMeasure *m = &frame->measures[i];
+    if (m->index < frame->len) {
+      struct WuiSubView *child = &frame->subviews[m->index];
+      child->vtable.measure(child->context, m->proposal);
+    }
+  }
+}
+
+static void replay_size(ReplayFrame *frame, struct WuiSize recorded, const struct WuiLayoutTraceReplayer *replayer) {
+  struct WuiLayoutTraceReplayStats *stats = frame->stats;
+  stats->size_calls++;
+  uint64_t start = wui_now_ns();
+  if (replayer != NULL && replayer->size_that_fits != NULL) {
+    struct WuiProposalSize proposal = {frame->header[0], frame->header[1]};
+    struct WuiSize size = replayer->size_that_fits(replayer->context, frame->layout_id, proposal, frame_array(frame));
+    if (memcmp(&size, &recorded, sizeof(size)) != 0) {
+      stats->mismatched_results++;
+    }
+  } else {
+    replay_measures(frame);
+  }
+  stats->elapsed_ns += wui_now_ns() - start;
+}
+
+static void replay_place(ReplayFrame *frame,
+                         const struct WuiRect *recorded,
+                         uint32_t recorded_len,
+                         const struct WuiLayoutTraceReplayer *replayer) {
+  struct WuiLayoutTraceReplayStats *stats = frame->stats;
+  stats->place_calls++;
+  uint64_t start = wui_now_ns();
+  if (replayer != NULL && replayer->place != NULL) {
+    struct WuiRect bounds = {{frame->header[0], frame->header[1]}, {frame->header[2], frame->header[3]}};
+    struct WuiArray_WuiRect rects = replayer->place(replayer->context, frame->layout_id, bounds, frame_array(frame));
+    struct WuiArraySlice_WuiRect slice = rects.vtable.slice(rects.data);
+    if (slice.len != recorded_len ||
+        (recorded_len > 0 && memcmp(slice.head, recorded, recorded_len * sizeof(struct WuiRect)) != 0)) {
+      stats->mismatched_results++;
+    }
+    rects.vtable.drop(rects.data);
+  } else {
+    replay_measures(frame);
+  }
+  stats->elapsed_ns += wui_now_ns() - start;
+}
+
+bool waterui_layout_trace_replay(const uint8_t *data,
+                                 uintptr_t len,
+                                 const struct WuiLayoutTraceReplayer *replayer,
+                                 struct WuiLayoutTraceReplayStats *out_stats) {
+  struct WuiLayoutTraceReplayStats stats;
+  memset(&stats, 0, sizeof(stats));
+  Reader reader = {data, data + len, true};
+
+  char magic[4];
+  uint16_t version = 0;
+  uint16_t byte_order = 0;
+  read_bytes(&reader, magic, sizeof(magic));
+  read_bytes(&reader, &version, sizeof(version));
+  read_bytes(&reader, &byte_order, sizeof(byte_order));
+  // A trace from a host of the other byte order fails the mark check.
+  if (!reader.ok || memcmp(magic, "WUIT", 4) != 0 || byte_order != WUI_LAYOUT_TRACE_BYTE_ORDER_MARK ||
+      version != WUI_LAYOUT_TRACE_VERSION) {
+    *out_stats = stats;
+    return false;
+  }
+
+  ReplayFrame **stack = NULL;
+  size_t depth = 0;
+  size_t stack_cap = 0;
+  struct WuiRect *rects = NULL;
+
+  while (reader.ok && reader.cursor < reader.end) {
+    uint8_t tag;
+    read_bytes(&reader, &tag, sizeof(tag));
+
+    switch (tag) {
+      case WuiLayoutTraceTag_SizeCall:
+      case WuiLayoutTraceTag_PlaceCall: {
+        ReplayFrame *frame = read_call(&reader, tag, &stats);
+        if (frame == NULL) {
+          break;
+        }
+        if (depth == stack_cap) {
+          size_t cap = stack_cap == 0 ? 16 : stack_cap * 2;
+          ReplayFrame **grown = realloc(stack, cap * sizeof(ReplayFrame *));
+          if (grown == NULL) {
+            free_frame(frame);
+            reader.ok = false;
+            break;
+          }
+          stack = grown;
+          stack_cap = cap;
+        }
+        stack[depth++] = frame;
+        break;
+      }
+      case WuiLayoutTraceTag_Measure: {
+        ReplayMeasure measure;
+        measure.index = read_u32(&reader);
+        measure.proposal.width = read_f32(&reader);
+        measure.proposal.height = read_f32(&reader);
+        measure.size.width = read_f32(&reader);
+        measure.size.height = read_f32(&reader);
+        if (!reader.ok || depth == 0 || !push_measure(stack[depth - 1], measure)) {
+          reader.ok = false;
+        }
+        break;
+      }
+      case WuiLayoutTraceTag_SizeResult: {
+        struct WuiSize size;
+        size.width = read_f32(&reader);
+        size.height = read_f32(&reader);
+        if (!reader.ok || depth == 0 || stack[depth - 1]->tag != WuiLayoutTraceTag_SizeCall) {
+          reader.ok = false;
+          break;
+        }
+        ReplayFrame *frame = stack[--depth];
+        replay_size(frame, size, replayer);
+        free_frame(frame);
+        break;
+      }
+      case WuiLayoutTraceTag_PlaceResult: {
+        uint32_t count = read_u32(&reader);
+        if (!reader.ok || depth == 0 || stack[depth - 1]->tag != WuiLayoutTraceTag_PlaceCall ||
+            count > (size_t)(reader.end - reader.cursor) / sizeof(struct WuiRect)) {
+          reader.ok = false;
+          break;
+        }
+        free(rects);
+        rects = count > 0 ? malloc(count * sizeof(struct WuiRect)) : NULL;
+        if (count > 0 && rects == NULL) {
+          reader.ok = false;
+          break;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+          rects[i].origin.x = read_f32(&reader);
+          rects[i].origin.y = read_f32(&reader);
+          rects[i].size.width = read_f32(&reader);
+          rects[i].size.height = read_f32(&reader);
+        }
+        ReplayFrame *frame = stack[--depth];
+        replay_place(frame, rects, count, replayer);
+        free_frame(frame);
+        break;
+      }
+      default:
+        reader.ok = false;
+        break;
+    }
+  }
+
+  // A recording stopped mid-call leaves frames open; they are dropped, not an error.
+  while (depth > 0) {
+    free_frame(stack[--depth]);
+  }
+  free(stack);
+  free(rects);
+  *out_stats = stats;
+  return reader.ok;
+}
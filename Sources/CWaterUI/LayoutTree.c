@@ -0,0 +1,401 @@
+// Flattened layout tree. See include/waterui_layout_tree.h.
+
+#include "LayoutStatsRecorder.h"
+#include "LayoutTraceRecorder.h"
+#include "ProposalKey.h"
+#include "waterui_layout_tree.h"
+
+// Memoized proposals per node. Containers are probed by their parent with a handful of
+// proposals per pass; without the memo every probe would re-run the whole subtree.
+#define WUI_TREE_MEMO 4
+
+enum {
+  // The node's layout must run again even if its frame size is unchanged.
+  WUI_TREE_NODE_DIRTY = 1 << 0,
+  // The node has been placed at least once; `placed_sizes` is meaningful.
+  WUI_TREE_NODE_PLACED = 1 << 1,
+};
+
+typedef struct NodeRef {
+  struct WuiLayoutTree *tree;
+  uint32_t index;
+} NodeRef;
+
+struct WuiLayoutTree {
+  uint32_t len;
+  uint32_t capacity;
+  uint32_t *parents;
+  uint32_t *first_children;
+  uint32_t *child_counts;
+  uint8_t *flags;
+  // NULL for leaves.
+  struct WuiLayout **layouts;
+  struct WuiSubView *leaves;
+  // What the parent's layout sees for each node: a trampoline into the tree that also
+  // carries the node's stretch axis and priority. Siblings are adjacent, so a node's
+  // children are the slice `spans[i]` of this array.
+  struct WuiSubView *entries;
+  struct WuiArraySlice_WuiSubView *spans;
+  NodeRef *refs;
+  uint64_t *memo_keys;
+  struct WuiSize *memo_sizes;
+  uint8_t *memo_lens;
+  uint8_t *memo_next;
+  struct WuiRect *frames;
+  struct WuiSize *placed_sizes;
+};
+
+static struct WuiSize empty_measure(void *context, struct WuiProposalSize proposal) {
+  (void)context;
+  (void)proposal;
+  struct WuiSize size = {0, 0};
+  return size;
+}
+
+static void empty_drop(void *context) {
+  (void)context;
+}
+
+static struct WuiSize tree_measure(struct WuiLayoutTree *tree, uint32_t node, struct WuiProposalSize proposal);
+
+static struct WuiSize entry_measure(void *context, struct WuiProposalSize proposal) {
+  const NodeRef *ref = context;
+  wui_stats_begin_measure();
+  struct WuiSize size = tree_measure(ref->tree, ref->index, proposal);
+  wui_stats_end_measure();
+  return size;
+}
+
+static void drop_leaf(struct WuiLayoutTree *tree, uint32_t node) {
+  struct WuiSubView *leaf = &tree->leaves[node];
+  if (leaf->vtable.drop != NULL) {
+    leaf->vtable.drop(leaf->context);
+  }
+  leaf->context = NULL;
+  leaf->vtable.measure = empty_measure;
+  leaf->vtable.drop = empty_drop;
+}
+
+// Re-points everything that refers into `entries` and `refs`, which may have moved.
+static void repoint(struct WuiLayoutTree *tree) {
+  for (uint32_t i = 0; i < tree->len; i++) {
+    tree->entries[i].context = &tree->refs[i];
+    tree->spans[i].head = tree->entries + tree->first_children[i];
+  }
+}
+
+#define GROW(field, count)                                                   \
+  do {                                                                       \
+    void *grown_field = realloc(tree->field, (count) * sizeof(*tree->field)); \
+    if (grown_field == NULL) {                                               \
+      goto failed;                                                           \
+    }                                                                        \
+    tree->field = grown_field;                                               \
+  } while (0)
+
+static bool reserve(struct WuiLayoutTree *tree, uint32_t capacity) {
+  if (capacity <= tree->capacity) {
+    return true;
+  }
+  uint32_t grown = tree->capacity * 2;
+  if (grown < capacity) {
+    grown = capacity;
+  }
+  // Counted once per growth, which reallocates each of the parallel arrays below.
+  wui_stats_allocation();
+  GROW(parents, grown);
+  GROW(first_children, grown);
+  GROW(child_counts, grown);
+  GROW(flags, grown);
+  GROW(layouts, grown);
+  GROW(leaves, grown);
+  GROW(entries, grown);
+  GROW(spans, grown);
+  GROW(refs, grown);
+  GROW(memo_keys, (size_t)grown * WUI_TREE_MEMO);
+  GROW(memo_sizes, (size_t)grown * WUI_TREE_MEMO);
+  GROW(memo_lens, grown);
+  GROW(memo_next, grown);
+  GROW(frames, grown);
+  GROW(placed_sizes, grown);
+  tree->capacity = grown;
+  repoint(tree);
+  return true;
+
+failed:
+  // The arrays grown before the failure keep their contents and are merely larger than
+  // `capacity` says, but `entries` or `refs` may have moved with them.
+  repoint(tree);
+  return false;
+}
+
+#undef GROW
+
+struct WuiLayoutTree *waterui_layout_tree_new(uint32_t capacity) {
+  struct WuiLayoutTree *tree = calloc(1, sizeof(struct WuiLayoutTree));
+  if (tree == NULL) {
+    return NULL;
+  }
+  if (!reserve(tree, capacity)) {
+    waterui_layout_tree_drop(tree);
+    return NULL;
+  }
+  return tree;
+}
+
+void waterui_layout_tree_drop(struct WuiLayoutTree *tree) {
+  if (tree == NULL) {
+    return;
+  }
+  waterui_layout_tree_clear(tree);
+  free(tree->parents);
+  free(tree->first_children);
+  free(tree->child_counts);
+  free(tree->flags);
+  free(tree->layouts);
+  free(tree->leaves);
+  free(tree->entries);
+  free(tree->spans);
+  free(tree->refs);
+  free(tree->memo_keys);
+  free(tree->memo_sizes);
+  free(tree->memo_lens);
+  free(tree->memo_next);
+  free(tree->frames);
+  free(tree->placed_sizes);
+  free(tree);
+}
+
+void waterui_layout_tree_clear(struct WuiLayoutTree *tree) {
+  for (uint32_t i = 0; i < tree->len; i++) {
+    drop_leaf(tree, i);
+  }
+  tree->len = 0;
+}
+
+uint32_t waterui_layout_tree_len(const struct WuiLayoutTree *tree) {
+  return tree->len;
+}
+
+static uint32_t append(struct WuiLayoutTree *tree, uint32_t parent, uint32_t count) {
+  if (count > UINT32_MAX - 1 - tree->len || !reserve(tree, tree->len + count)) {
+    return WUI_LAYOUT_TREE_NONE;
+  }
+  uint32_t first = tree->len;
+  for (uint32_t i = first; i < first + count; i++) {
+    tree->parents[i] = parent;
+    tree->first_children[i] = i;
+    tree->child_counts[i] = 0;
+    tree->flags[i] = WUI_TREE_NODE_DIRTY;
+    tree->layouts[i] = NULL;
+    tree->leaves[i].context = NULL;
+    tree->leaves[i].vtable.measure = empty_measure;
+    tree->leaves[i].vtable.drop = empty_drop;
+    tree->leaves[i].stretch_axis = WuiStretchAxis_None;
+    tree->leaves[i].priority = 0;
+    tree->refs[i].tree = tree;
+    tree->refs[i].index = i;
+    tree->entries[i].context = &tree->refs[i];
+    tree->entries[i].vtable.measure = entry_measure;
+    tree->entries[i].vtable.drop = empty_drop;
+    tree->entries[i].stretch_axis = WuiStretchAxis_None;
+    tree->entries[i].priority = 0;
+    tree->spans[i].head = tree->entries + i;
+    tree->spans[i].len = 0;
+    tree->memo_lens[i] = 0;
+    tree->memo_next[i] = 0;
+    tree->frames[i] = (struct WuiRect){{0, 0}, {0, 0}};
+    tree->placed_sizes[i] = (struct WuiSize){0, 0};
+  }
+  tree->len += count;
+  return first;
+}
+
+uint32_t waterui_layout_tree_add_root(struct WuiLayoutTree *tree) {
+  if (tree->len != 0) {
+    return WUI_LAYOUT_TREE_NONE;
+  }
+  return append(tree, WUI_LAYOUT_TREE_NONE, 1);
+}
+
+uint32_t waterui_layout_tree_add_children(struct WuiLayoutTree *tree, uint32_t parent, uint32_t count) {
+  if (parent >= tree->len || tree->child_counts[parent] != 0) {
+    return WUI_LAYOUT_TREE_NONE;
+  }
+  uint32_t first = append(tree, parent, count);
+  if (first == WUI_LAYOUT_TREE_NONE) {
+    return first;
+  }
+  tree->first_children[parent] = first;
+  tree->child_counts[parent] = count;
+  tree->spans[parent].head = tree->entries + first;
+  tree->spans[parent].len = count;
+  waterui_layout_tree_mark_dirty(tree, parent);
+  return first;
+}
+
+void waterui_layout_tree_set_layout(struct WuiLayoutTree *tree, uint32_t node, struct WuiLayout *layout) {
+  if (node >= tree->len) {
+    return;
+  }
+  drop_leaf(tree, node);
+  tree->layouts[node] = layout;
+  waterui_layout_tree_mark_dirty(tree, node);
+}
+
+void waterui_layout_tree_set_leaf(struct WuiLayoutTree *tree, uint32_t node, struct WuiSubView leaf) {
+  if (node >= tree->len) {
+    if (leaf.vtable.drop != NULL) {
+      leaf.vtable.drop(leaf.context);
+    }
+    return;
+  }
+  drop_leaf(tree, node);
+  tree->layouts[node] = NULL;
+  tree->leaves[node] = leaf;
+  tree->entries[node].stretch_axis = leaf.stretch_axis;
+  tree->entries[node].priority = leaf.priority;
+  waterui_layout_tree_mark_dirty(tree, node);
+}
+
+void waterui_layout_tree_set_traits(struct WuiLayoutTree *tree,
+                                    uint32_t node,
+                                    enum WuiStretchAxis stretch_axis,
+                                    int32_t priority) {
+  if (node >= tree->len) {
+    return;
+  }
+  tree->entries[node].stretch_axis = stretch_axis;
+  tree->entries[node].priority = priority;
+  waterui_layout_tree_mark_dirty(tree, node);
+}
+
+void waterui_layout_tree_mark_dirty(struct WuiLayoutTree *tree, uint32_t node) {
+  for (uint32_t i = node; i < tree->len; i = tree->parents[i]) {
+    tree->memo_lens[i] = 0;
+    tree->memo_next[i] = 0;
+    tree->flags[i] |= WUI_TREE_NODE_DIRTY;
+  }
+}
+
+uint32_t waterui_layout_tree_parent(const struct WuiLayoutTree *tree, uint32_t node) {
+  return node < tree->len ? tree->parents[node] : WUI_LAYOUT_TREE_NONE;
+}
+
+static void borrowed_array_drop(void *data) {
+  (void)data;
+}
+
+static struct WuiArraySlice_WuiSubView borrowed_array_slice(const void *data) {
+  return *(const struct WuiArraySlice_WuiSubView *)data;
+}
+
+static struct WuiArray_WuiSubView children_array(struct WuiLayoutTree *tree, uint32_t node) {
+  struct WuiArray_WuiSubView array;
+  array.data = &tree->spans[node];
+  array.vtable.drop = borrowed_array_drop;
+  array.vtable.slice = borrowed_array_slice;
+  return array;
+}
+
+static struct WuiSize tree_measure(struct WuiLayoutTree *tree, uint32_t node, struct WuiProposalSize proposal) {
+  uint64_t key = wui_proposal_key(proposal);
+  const uint64_t *keys = tree->memo_keys + (size_t)node * WUI_TREE_MEMO;
+  struct WuiSize *sizes = tree->memo_sizes + (size_t)node * WUI_TREE_MEMO;
+  for (uint8_t i = 0; i < tree->memo_lens[node]; i++) {
+    if (keys[i] == key) {
+      return sizes[i];
+    }
+  }
+
+  struct WuiSize size;
+  struct WuiLayout *layout = tree->layouts[node];
+  if (layout != NULL) {
+    struct WuiArray_WuiSubView children = children_array(tree, node);
+    struct WuiTraceCall *trace = wui_trace_begin_size(layout, proposal, &children);
+    wui_stats_begin_call(false);
+    size = waterui_layout_size_that_fits(layout, proposal, children);
+    wui_stats_end_call();
+    wui_trace_end_size(trace, size);
+  } else {
+    size = tree->leaves[node].vtable.measure(tree->leaves[node].context, proposal);
+  }
+
+  uint8_t slot;
+  if (tree->memo_lens[node] < WUI_TREE_MEMO) {
+    slot = tree->memo_lens[node]++;
+  } else {
+    slot = tree->memo_next[node];
+    tree->memo_next[node] = (uint8_t)((slot + 1) % WUI_TREE_MEMO);
+  }
+  tree->memo_keys[(size_t)node * WUI_TREE_MEMO + slot] = key;
+  sizes[slot] = size;
+  return size;
+}
+
+struct WuiSize waterui_layout_tree_size_that_fits(struct WuiLayoutTree *tree,
+                                                  uint32_t node,
+                                                  struct WuiProposalSize proposal) {
+  if (node >= tree->len) {
+    struct WuiSize size = {0, 0};
+    return size;
+  }
+  return tree_measure(tree, node, proposal);
+}
+
+static bool same_size(struct WuiSize a, struct WuiSize b) {
+  return a.width == b.width && a.height == b.height;
+}
+
+static void place_node(struct WuiLayoutTree *tree, uint32_t node) {
+  struct WuiLayout *layout = tree->layouts[node];
+  struct WuiSize size = tree->frames[node].size;
+  struct WuiRect bounds = {{0, 0}, size};
+  struct WuiProposalSize proposal = {size.width, size.height};
+
+  // Size first, as the platform containers do, so the layout sees the same negotiation.
+  tree_measure(tree, node, proposal);
+
+  struct WuiArray_WuiSubView children = children_array(tree, node);
+  struct WuiTraceCall *trace = wui_trace_begin_place(layout, bounds, &children);
+  wui_stats_begin_call(true);
+  struct WuiArray_WuiRect rects = waterui_layout_place(layout, bounds, children);
+  wui_stats_end_call();
+  wui_stats_allocation();
+  wui_trace_end_place(trace, rects);
+
+  struct WuiArraySlice_WuiRect slice = rects.vtable.slice(rects.data);
+  uint32_t first = tree->first_children[node];
+  uint32_t count = tree->child_counts[node];
+  if (slice.len < count) {
+    count = (uint32_t)slice.len;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    tree->frames[first + i] = slice.head[i];
+  }
+  rects.vtable.drop(rects.data);
+}
+
+void waterui_layout_tree_compute(struct WuiLayoutTree *tree, struct WuiRect root_frame) {
+  if (tree->len == 0) {
+    return;
+  }
+  tree->frames[0] = root_frame;
+  for (uint32_t i = 0; i < tree->len; i++) {
+    if (tree->layouts[i] == NULL || tree->child_counts[i] == 0) {
+      continue;
+    }
+    struct WuiSize size = tree->frames[i].size;
+    bool resized = (tree->flags[i] & WUI_TREE_NODE_PLACED) == 0 || !same_size(size, tree->placed_sizes[i]);
+    if (!resized && (tree->flags[i] & WUI_TREE_NODE_DIRTY) == 0) {
+      continue;
+    }
+    place_node(tree, i);
+    tree->placed_sizes[i] = size;
+    tree->flags[i] = WUI_TREE_NODE_PLACED;
+  }
+}
+
+const struct WuiRect *waterui_layout_tree_frames(const struct WuiLayoutTree *tree) {
+  return tree->frames;
+}
@@ -0,0 +1,30 @@
+// Main-thread checks for unlocked native state. Not part of the public headers.
+
+#ifndef WATERUI_MAIN_THREAD_H
+#define WATERUI_MAIN_THREAD_H
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+/**
+ * Asserts, in debug builds, that the caller runs on the main thread. Off Apple platforms
+ * the first thread to check in each file stands in for it.
+ */
+static inline void wui_assert_main_thread(void) {
+#ifndef NDEBUG
+#if defined(__APPLE__)
+  assert(pthread_main_np() != 0 && "main-thread only");
+#else
+  static pthread_t owner;
+  static bool owned;
+  if (!owned) {
+    owner = pthread_self();
+    owned = true;
+  }
+  assert(pthread_equal(owner, pthread_self()) && "main-thread only");
+#endif
+#endif
+}
+
+#endif /* WATERUI_MAIN_THREAD_H */
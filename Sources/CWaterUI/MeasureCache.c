@@ -0,0 +1,281 @@
+// Proposal-keyed measurement memo for SubViews. See include/waterui_subview.h.
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "LayoutStatsRecorder.h"
+#include "ProposalKey.h"
+#include "waterui_subview.h"
+
+// Layouts rarely probe a child with more than a handful of distinct proposals per pass
+// (unspecified, zero, infinity, the offered size), so a small table scanned linearly is
+// cheaper than hashing.
+#define WUI_MEASURE_CACHE_ENTRIES 8
+#define WUI_MEASURE_CHUNK 64
+
+struct WuiMeasureCache {
+  struct WuiSubView inner;
+  const struct WuiSubViewBatchVTable *inner_batch;
+  uint32_t flags;
+  uint64_t keys[WUI_MEASURE_CACHE_ENTRIES];
+  struct WuiSize sizes[WUI_MEASURE_CACHE_ENTRIES];
+  uint8_t len;
+  uint8_t next;
+  // Set once an entry has been overwritten; the table then no longer covers every
+  // proposal asked since the last invalidation.
+  bool evicted;
+  // The proposals asked before the last invalidation; `waterui_measure_cache_prefetch`
+  // replays them, since the next pass usually asks the same ones again.
+  uint64_t stale_keys[WUI_MEASURE_CACHE_ENTRIES];
+  uint8_t stale_len;
+  struct WuiMeasureCacheStats stats;
+};
+
+// Caches may be filled from a measure pool's workers, so the shared counters are atomic.
+static struct {
+  atomic_uint_least64_t hits;
+  atomic_uint_least64_t misses;
+  atomic_uint_least64_t invalidations;
+} global_stats;
+
+static void count(atomic_uint_least64_t *counter) {
+  atomic_fetch_add_explicit(counter, 1, memory_order_relaxed);
+}
+
+static bool cache_find(const struct WuiMeasureCache *cache, uint64_t key, struct WuiSize *out) {
+  for (uint8_t i = 0; i < cache->len; i++) {
+    if (cache->keys[i] == key) {
+      *out = cache->sizes[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool cache_lookup(struct WuiMeasureCache *cache, uint64_t key, struct WuiSize *out) {
+  if (cache_find(cache, key, out)) {
+    cache->stats.hits++;
+    count(&global_stats.hits);
+    return true;
+  }
+  cache->stats.misses++;
+  count(&global_stats.misses);
+  return false;
+}
+
+static void cache_store(struct WuiMeasureCache *cache, uint64_t key, struct WuiSize size) {
+  uint8_t slot;
+  if (cache->len < WUI_MEASURE_CACHE_ENTRIES) {
+    slot = cache->len++;
+  } else {
+    slot = cache->next;
+    cache->evicted = true;
+    cache->next = (uint8_t)((cache->next + 1) % WUI_MEASURE_CACHE_ENTRIES);
+  }
+  cache->keys[slot] = key;
+  cache->sizes[slot] = size;
+}
+
+struct WuiMeasureCache *waterui_measure_cache_new(struct WuiSubView inner,
+                                                  const struct WuiSubViewBatchVTable *inner_batch,
+                                                  uint32_t flags) {
+  struct WuiMeasureCache *cache = calloc(1, sizeof(struct WuiMeasureCache));
+  if (cache == NULL) {
+    return NULL;
+  }
+  wui_stats_allocation();
+  cache->inner = inner;
+  cache->inner_batch = inner_batch;
+  cache->flags = flags;
+  return cache;
+}
+
+uint32_t waterui_measure_cache_flags(const struct WuiMeasureCache *cache) {
+  return cache->flags;
+}
+
+void waterui_measure_cache_drop(struct WuiMeasureCache *cache) {
+  if (cache == NULL) {
+    return;
+  }
+  if (cache->inner.vtable.drop != NULL) {
+    cache->inner.vtable.drop(cache->inner.context);
+  }
+  free(cache);
+}
+
+struct WuiSize waterui_measure_cache_measure(struct WuiMeasureCache *cache,
+                                             struct WuiProposalSize proposal) {
+  uint64_t key = wui_proposal_key(proposal);
+  struct WuiSize size;
+  if (cache_lookup(cache, key, &size)) {
+    return size;
+  }
+  size = cache->inner.vtable.measure(cache->inner.context, proposal);
+  cache_store(cache, key, size);
+  return size;
+}
+
+static struct WuiSize cached_measure(void *context, struct WuiProposalSize proposal) {
+  wui_stats_begin_measure();
+  struct WuiSize size = waterui_measure_cache_measure((struct WuiMeasureCache *)context, proposal);
+  wui_stats_end_measure();
+  return size;
+}
+
+static void borrowed_drop(void *context) {
+  (void)context;
+}
+
+struct WuiSubView waterui_measure_cache_subview(struct WuiMeasureCache *cache) {
+  struct WuiSubView subview;
+  subview.context = cache;
+  subview.vtable.measure = cached_measure;
+  subview.vtable.drop = borrowed_drop;
+  subview.stretch_axis = cache->inner.stretch_axis;
+  subview.priority = cache->inner.priority;
+  return subview;
+}
+
+void waterui_measure_cache_invalidate(struct WuiMeasureCache *cache) {
+  if (cache->len > 0) {
+    memcpy(cache->stale_keys, cache->keys, cache->len * sizeof(uint64_t));
+    cache->stale_len = cache->len;
+  }
+  cache->len = 0;
+  cache->next = 0;
+  cache->evicted = false;
+  cache->stats.invalidations++;
+  count(&global_stats.invalidations);
+}
+
+static void prefetch_key(struct WuiMeasureCache *cache, uint64_t key) {
+  struct WuiSize size;
+  if (cache_find(cache, key, &size)) {
+    return;
+  }
+  size = cache->inner.vtable.measure(cache->inner.context, wui_proposal_from_key(key));
+  cache_store(cache, key, size);
+}
+
+void waterui_measure_cache_prefetch(struct WuiMeasureCache *cache, struct WuiProposalSize proposal) {
+  prefetch_key(cache, wui_proposal_key(proposal));
+  for (uint8_t i = 0; i < cache->stale_len; i++) {
+    prefetch_key(cache, cache->stale_keys[i]);
+  }
+}
+
+bool waterui_measure_cache_revalidate(struct WuiMeasureCache *cache) {
+  bool changed = cache->len == 0 || cache->evicted;
+  for (uint8_t i = 0; i < cache->len; i++) {
+    struct WuiSize size = cache->inner.vtable.measure(cache->inner.context, wui_proposal_from_key(cache->keys[i]));
+    if (memcmp(&size, &cache->sizes[i], sizeof(size)) != 0) {
+      cache->sizes[i] = size;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+struct WuiMeasureCacheStats waterui_measure_cache_stats(const struct WuiMeasureCache *cache) {
+  return cache->stats;
+}
+
+struct WuiMeasureCacheStats waterui_measure_cache_global_stats(void) {
+  struct WuiMeasureCacheStats stats;
+  stats.hits = atomic_load_explicit(&global_stats.hits, memory_order_relaxed);
+  stats.misses = atomic_load_explicit(&global_stats.misses, memory_order_relaxed);
+  stats.invalidations = atomic_load_explicit(&global_stats.invalidations, memory_order_relaxed);
+  return stats;
+}
+
+void waterui_measure_cache_reset_global_stats(void) {
+  atomic_store_explicit(&global_stats.hits, 0, memory_order_relaxed);
+  atomic_store_explicit(&global_stats.misses, 0, memory_order_relaxed);
+  atomic_store_explicit(&global_stats.invalidations, 0, memory_order_relaxed);
+}
+
+// Misses sharing the inner batch entry of the first batchable miss are forwarded
+// together; any other miss is measured on its own.
+static void measure_many_uncounted(void *const *contexts,
+                                const struct WuiProposalSize *proposals,
+                                struct WuiSize *out_sizes,
+                                uintptr_t n) {
+  void *miss_contexts[WUI_MEASURE_CHUNK];
+  struct WuiProposalSize miss_proposals[WUI_MEASURE_CHUNK];
+  struct WuiSize miss_sizes[WUI_MEASURE_CHUNK];
+  uintptr_t miss_targets[WUI_MEASURE_CHUNK];
+
+  for (uintptr_t start = 0; start < n; start += WUI_MEASURE_CHUNK) {
+    uintptr_t end = n - start < WUI_MEASURE_CHUNK ? n : start + WUI_MEASURE_CHUNK;
+    const struct WuiSubViewBatchVTable *batch = NULL;
+    uintptr_t misses = 0;
+
+    for (uintptr_t i = start; i < end; i++) {
+      struct WuiMeasureCache *cache = contexts[i];
+      uint64_t key = wui_proposal_key(proposals[i]);
+      if (cache_lookup(cache, key, &out_sizes[i])) {
+        continue;
+      }
+
+      const struct WuiSubViewBatchVTable *inner_batch = cache->inner_batch;
+      bool batchable = inner_batch != NULL && inner_batch->measure_many != NULL &&
+                       cache->inner.vtable.measure == inner_batch->measure;
+      if (batchable && (batch == NULL || batch == inner_batch)) {
+        batch = inner_batch;
+        miss_contexts[misses] = cache->inner.context;
+        miss_proposals[misses] = proposals[i];
+        miss_targets[misses] = i;
+        misses++;
+      } else {
+        out_sizes[i] = cache->inner.vtable.measure(cache->inner.context, proposals[i]);
+        cache_store(cache, key, out_sizes[i]);
+      }
+    }
+
+    if (misses == 0) {
+      continue;
+    }
+    batch->measure_many(miss_contexts, miss_proposals, miss_sizes, misses);
+    for (uintptr_t m = 0; m < misses; m++) {
+      uintptr_t i = miss_targets[m];
+      out_sizes[i] = miss_sizes[m];
+      cache_store(contexts[i], wui_proposal_key(proposals[i]), miss_sizes[m]);
+    }
+  }
+}
+
+// Bracketed like `cached_measure`, so a batch counts as one callback in the layout stats.
+static void cached_measure_many(void *const *contexts,
+                                const struct WuiProposalSize *proposals,
+                                struct WuiSize *out_sizes,
+                                uintptr_t n) {
+  wui_stats_begin_measure();
+  measure_many_uncounted(contexts, proposals, out_sizes, n);
+  wui_stats_end_measure();
+}
+
+static const struct WuiSubViewBatchVTable cache_batch_vtable = {
+    cached_measure,
+    cached_measure_many,
+};
+
+const struct WuiSubViewBatchVTable *waterui_measure_cache_batch_vtable(void) {
+  return &cache_batch_vtable;
+}
+
+void waterui_measure_cache_measure_proposals(struct WuiMeasureCache *cache,
+                                             const struct WuiProposalSize *proposals,
+                                             struct WuiSize *out_sizes,
+                                             uintptr_t n) {
+  // Every slot names the same cache, so the misses of one call share an inner batch entry
+  // and cross into the backend together.
+  void *contexts[WUI_MEASURE_CHUNK];
+  for (uintptr_t i = 0; i < WUI_MEASURE_CHUNK; i++) {
+    contexts[i] = cache;
+  }
+  for (uintptr_t start = 0; start < n; start += WUI_MEASURE_CHUNK) {
+    uintptr_t len = n - start < WUI_MEASURE_CHUNK ? n - start : WUI_MEASURE_CHUNK;
+    cached_measure_many(contexts, proposals + start, out_sizes + start, len);
+  }
+}
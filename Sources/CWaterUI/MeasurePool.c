@@ -0,0 +1,154 @@
+// Worker pool for measuring thread-safe children concurrently. See include/waterui_subview.h.
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "MeasurePool.h"
+
+// Workers claim children in runs of this many to keep contention on the shared cursor low
+// without starving the pool on small sets.
+#define WUI_PREFETCH_STRIDE 32
+
+typedef struct PrefetchJob {
+  struct WuiMeasureCache *const *caches;
+  const uint32_t *order;
+  uintptr_t len;
+  struct WuiProposalSize proposal;
+  atomic_uintptr_t cursor;
+} PrefetchJob;
+
+struct WuiMeasurePool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  pthread_t *threads;
+  uint32_t workers;
+  // Bumped for every job so that sleeping workers can tell a new job from a spurious wakeup.
+  uint64_t generation;
+  uint32_t busy;
+  bool shutdown;
+  PrefetchJob *job;
+};
+
+static void run_job(PrefetchJob *job) {
+  for (;;) {
+    uintptr_t start = atomic_fetch_add_explicit(&job->cursor, WUI_PREFETCH_STRIDE, memory_order_relaxed);
+    if (start >= job->len) {
+      return;
+    }
+    uintptr_t end = job->len - start < WUI_PREFETCH_STRIDE ? job->len : start + WUI_PREFETCH_STRIDE;
+    for (uintptr_t k = start; k < end; k++) {
+      uint32_t i = job->order[k];
+      struct WuiMeasureCache *cache = job->caches[i];
+      if (cache != NULL && (waterui_measure_cache_flags(cache) & WuiSubViewFlags_ThreadSafe) != 0) {
+        waterui_measure_cache_prefetch(cache, job->proposal);
+      }
+    }
+  }
+}
+
+static void *worker_main(void *data) {
+  struct WuiMeasurePool *pool = data;
+  uint64_t seen = 0;
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (!pool->shutdown && pool->generation == seen) {
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+    if (pool->shutdown) {
+      break;
+    }
+    seen = pool->generation;
+    PrefetchJob *job = pool->job;
+    pthread_mutex_unlock(&pool->lock);
+
+    run_job(job);
+
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->busy == 0) {
+      pthread_cond_signal(&pool->done);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+struct WuiMeasurePool *waterui_measure_pool_new(uint32_t workers) {
+  struct WuiMeasurePool *pool = calloc(1, sizeof(struct WuiMeasurePool));
+  if (pool == NULL) {
+    return NULL;
+  }
+  pool->threads = calloc(workers > 0 ? workers : 1, sizeof(pthread_t));
+  if (pool->threads == NULL) {
+    free(pool);
+    return NULL;
+  }
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+  for (uint32_t i = 0; i < workers; i++) {
+    if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+      break;
+    }
+    pool->workers++;
+  }
+  return pool;
+}
+
+void waterui_measure_pool_drop(struct WuiMeasurePool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  for (uint32_t i = 0; i < pool->workers; i++) {
+    pthread_join(pool->threads[i], NULL);
+  }
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->threads);
+  free(pool);
+}
+
+uint32_t waterui_measure_pool_workers(const struct WuiMeasurePool *pool) {
+  return pool->workers;
+}
+
+void wui_measure_pool_prefetch(struct WuiMeasurePool *pool,
+                               struct WuiMeasureCache *const *caches,
+                               const uint32_t *order,
+                               uintptr_t len,
+                               struct WuiProposalSize proposal) {
+  PrefetchJob job;
+  job.caches = caches;
+  job.order = order;
+  job.len = len;
+  job.proposal = proposal;
+  atomic_init(&job.cursor, 0);
+
+  // Not worth waking anyone for a single run.
+  bool parallel = pool != NULL && pool->workers > 0 && len > WUI_PREFETCH_STRIDE;
+  if (parallel) {
+    pthread_mutex_lock(&pool->lock);
+    pool->job = &job;
+    pool->busy = pool->workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  // The calling thread takes part instead of idling until the workers finish.
+  run_job(&job);
+
+  if (parallel) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) {
+      pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
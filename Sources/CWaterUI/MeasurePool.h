@@ -0,0 +1,20 @@
+// Pool dispatch used by WuiSubViews. Not part of the public headers.
+
+#ifndef WATERUI_MEASURE_POOL_H
+#define WATERUI_MEASURE_POOL_H
+
+#include "waterui_subview.h"
+
+/**
+ * Prefetches `proposal` into every cache created with
+ * `WuiSubViewFlags_ThreadSafe`, spreading the work over `pool` and the calling thread.
+ * Entries are handed out in the sequence given by `order`, a permutation of `len`
+ * indices. Returns once every cache is filled. `pool` may be NULL to prefetch serially.
+ */
+void wui_measure_pool_prefetch(struct WuiMeasurePool *pool,
+                               struct WuiMeasureCache *const *caches,
+                               const uint32_t *order,
+                               uintptr_t len,
+                               struct WuiProposalSize proposal);
+
+#endif /* WATERUI_MEASURE_POOL_H */
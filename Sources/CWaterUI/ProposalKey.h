@@ -0,0 +1,36 @@
+// Proposal keys shared by the native measure memos. Not part of the public headers.
+
+#ifndef WATERUI_PROPOSAL_KEY_H
+#define WATERUI_PROPOSAL_KEY_H
+
+#include <string.h>
+
+#include "waterui_ffi.h"
+
+static inline uint32_t wui_float_key(float value) {
+  uint32_t bits;
+  if (value != value) {
+    // Every NaN means "unspecified".
+    return 0x7fc00000u;
+  }
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * Packs the bit patterns of both dimensions into one comparable key.
+ */
+static inline uint64_t wui_proposal_key(struct WuiProposalSize proposal) {
+  return ((uint64_t)wui_float_key(proposal.width) << 32) | wui_float_key(proposal.height);
+}
+
+static inline struct WuiProposalSize wui_proposal_from_key(uint64_t key) {
+  uint32_t width_bits = (uint32_t)(key >> 32);
+  uint32_t height_bits = (uint32_t)key;
+  struct WuiProposalSize proposal;
+  memcpy(&proposal.width, &width_bits, sizeof(width_bits));
+  memcpy(&proposal.height, &height_bits, sizeof(height_bits));
+  return proposal;
+}
+
+#endif /* WATERUI_PROPOSAL_KEY_H */
@@ -0,0 +1,117 @@
+// Reference-counted byte buffers. See include/waterui_array.h.
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "waterui_array.h"
+
+// The storage a set of views share; `storage` is the array that was handed to
+// `waterui_bytes_share`, kept as it was.
+typedef struct SharedStorage {
+  atomic_uintptr_t refs;
+  struct WuiArray_u8 storage;
+} SharedStorage;
+
+// What a handle points to. Whole-buffer handles share one view; each slice has its own.
+typedef struct SharedView {
+  atomic_uintptr_t refs;
+  SharedStorage *storage;
+  uint8_t *head;
+  uintptr_t len;
+} SharedView;
+
+static void release_storage(SharedStorage *storage) {
+  if (atomic_fetch_sub_explicit(&storage->refs, 1, memory_order_acq_rel) == 1) {
+    storage->storage.vtable.drop(storage->storage.data);
+    free(storage);
+  }
+}
+
+static void shared_drop(void *data) {
+  SharedView *view = data;
+  if (atomic_fetch_sub_explicit(&view->refs, 1, memory_order_acq_rel) == 1) {
+    release_storage(view->storage);
+    free(view);
+  }
+}
+
+static struct WuiArraySlice_u8 shared_slice(const void *data) {
+  const SharedView *view = data;
+  struct WuiArraySlice_u8 slice;
+  slice.head = view->head;
+  slice.len = view->len;
+  return slice;
+}
+
+static struct WuiArray_u8 handle(SharedView *view) {
+  struct WuiArray_u8 bytes;
+  bytes.data = view;
+  bytes.vtable.drop = shared_drop;
+  bytes.vtable.slice = shared_slice;
+  return bytes;
+}
+
+static SharedView *view_new(SharedStorage *storage, uint8_t *head, uintptr_t len) {
+  SharedView *view = malloc(sizeof(SharedView));
+  if (view == NULL) {
+    abort();
+  }
+  atomic_init(&view->refs, 1);
+  view->storage = storage;
+  view->head = head;
+  view->len = len;
+  return view;
+}
+
+static struct WuiArray_u8 copy_bytes(const uint8_t *head, uintptr_t len) {
+  // Typed arrays share the generic array's layout, as the Swift side relies on too.
+  struct WuiArray array = waterui_array_copy(head, len, 1);
+  struct WuiArray_u8 bytes;
+  memcpy(&bytes, &array, sizeof(bytes));
+  return bytes;
+}
+
+struct WuiArray_u8 waterui_bytes_share(struct WuiArray_u8 bytes) {
+  if (bytes.vtable.slice == shared_slice) {
+    return bytes;
+  }
+  SharedStorage *storage = malloc(sizeof(SharedStorage));
+  if (storage == NULL) {
+    abort();
+  }
+  atomic_init(&storage->refs, 1);
+  storage->storage = bytes;
+  struct WuiArraySlice_u8 slice = bytes.vtable.slice(bytes.data);
+  return handle(view_new(storage, slice.head, slice.len));
+}
+
+bool waterui_bytes_is_shared(const struct WuiArray_u8 *bytes) {
+  return bytes->vtable.slice == shared_slice;
+}
+
+struct WuiArray_u8 waterui_bytes_retain(const struct WuiArray_u8 *bytes) {
+  if (bytes->vtable.slice != shared_slice) {
+    struct WuiArraySlice_u8 slice = bytes->vtable.slice(bytes->data);
+    return copy_bytes(slice.head, slice.len);
+  }
+  SharedView *view = bytes->data;
+  atomic_fetch_add_explicit(&view->refs, 1, memory_order_relaxed);
+  return handle(view);
+}
+
+struct WuiArray_u8 waterui_bytes_slice(const struct WuiArray_u8 *bytes, uintptr_t start, uintptr_t len) {
+  struct WuiArraySlice_u8 slice = bytes->vtable.slice(bytes->data);
+  if (start > slice.len) {
+    start = slice.len;
+  }
+  if (len > slice.len - start) {
+    len = slice.len - start;
+  }
+  if (bytes->vtable.slice != shared_slice) {
+    return copy_bytes(slice.head + start, len);
+  }
+  SharedStorage *storage = ((SharedView *)bytes->data)->storage;
+  atomic_fetch_add_explicit(&storage->refs, 1, memory_order_relaxed);
+  return handle(view_new(storage, slice.head + start, len));
+}
@@ -0,0 +1,120 @@
+// Small-string cells. See include/waterui_str.h.
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "waterui_array.h"
+#include "waterui_str.h"
+
+// Most threads only ever hold a few short strings at once; cells dropped beyond this many
+// go back to the system.
+#define WUI_SMALL_STR_CACHED 64
+
+typedef struct SmallCell {
+  union {
+    // Link in a thread's free list while the cell is unused.
+    struct SmallCell *next;
+    uintptr_t len;
+  };
+  uint8_t bytes[WUI_SMALL_STR_CAPACITY];
+} SmallCell;
+
+// Each thread recycles cells through its own free list, so taking and returning one needs
+// no lock. A cell dropped on another thread than the one that made it joins that thread's
+// list. The list lives behind a pthread key whose destructor frees it when the thread
+// exits.
+typedef struct CellCache {
+  SmallCell *free;
+  uint32_t count;
+} CellCache;
+
+static pthread_key_t cache_key;
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static bool cache_key_ready;
+
+static void cache_free(void *value) {
+  CellCache *cache = value;
+  for (SmallCell *cell = cache->free; cell != NULL;) {
+    SmallCell *next = cell->next;
+    free(cell);
+    cell = next;
+  }
+  free(cache);
+}
+
+static void cache_key_create(void) {
+  cache_key_ready = pthread_key_create(&cache_key, cache_free) == 0;
+}
+
+static CellCache *current_cache(void) {
+  pthread_once(&cache_key_once, cache_key_create);
+  return cache_key_ready ? pthread_getspecific(cache_key) : NULL;
+}
+
+static struct WuiArraySlice_u8 small_slice(const void *data) {
+  const SmallCell *cell = data;
+  struct WuiArraySlice_u8 slice;
+  slice.head = (uint8_t *)cell->bytes;
+  slice.len = cell->len;
+  return slice;
+}
+
+static void small_drop(void *data) {
+  SmallCell *cell = data;
+  CellCache *cache = current_cache();
+  if (cache == NULL) {
+    // Drops that happen before the thread's first string, or during its teardown, are
+    // not worth setting up a cache for.
+    free(cell);
+    return;
+  }
+  if (cache->count == WUI_SMALL_STR_CACHED) {
+    free(cell);
+    return;
+  }
+  cell->next = cache->free;
+  cache->free = cell;
+  cache->count++;
+}
+
+static SmallCell *cell_take(void) {
+  CellCache *cache = current_cache();
+  if (cache == NULL && cache_key_ready) {
+    cache = calloc(1, sizeof(CellCache));
+    if (cache != NULL && pthread_setspecific(cache_key, cache) != 0) {
+      free(cache);
+      cache = NULL;
+    }
+  }
+  SmallCell *cell;
+  if (cache != NULL && cache->free != NULL) {
+    cell = cache->free;
+    cache->free = cell->next;
+    cache->count--;
+  } else {
+    cell = malloc(sizeof(SmallCell));
+    if (cell == NULL) {
+      abort();
+    }
+  }
+  return cell;
+}
+
+struct WuiStr waterui_str_new(const uint8_t *bytes, uintptr_t len) {
+  struct WuiStr str;
+  if (len == 0 || len > WUI_SMALL_STR_CAPACITY) {
+    // Typed arrays share the generic array's layout, as the Swift side relies on too.
+    struct WuiArray array = waterui_array_copy(bytes, len, 1);
+    memcpy(&str._0, &array, sizeof(str._0));
+    return str;
+  }
+  SmallCell *cell = cell_take();
+  cell->len = len;
+  memcpy(cell->bytes, bytes, len);
+  str._0.data = cell;
+  str._0.vtable.drop = small_drop;
+  str._0.vtable.slice = small_slice;
+  return str;
+}
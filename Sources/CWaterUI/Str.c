@@ -0,0 +1,80 @@
+// Native-side string helpers. See include/waterui_str.h.
+
+#include "waterui_str.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WUI_UTF8_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define WUI_UTF8_NEON 1
+#endif
+
+// Returns the index of the first non-ASCII byte at or after `i`, or `len`.
+static uintptr_t skip_ascii(const uint8_t *bytes, uintptr_t i, uintptr_t len) {
+#if WUI_UTF8_SSE2
+  for (; len - i >= 16; i += 16) {
+    if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(bytes + i))) != 0) {
+      break;
+    }
+  }
+#elif WUI_UTF8_NEON
+  for (; len - i >= 16; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(bytes + i)) >= 0x80) {
+      break;
+    }
+  }
+#endif
+  while (i < len && bytes[i] < 0x80) {
+    i++;
+  }
+  return i;
+}
+
+bool waterui_utf8_is_ascii(const uint8_t *bytes, uintptr_t len) {
+  return skip_ascii(bytes, 0, len) == len;
+}
+
+bool waterui_utf8_valid(const uint8_t *bytes, uintptr_t len) {
+  uintptr_t i = 0;
+  for (;;) {
+    i = skip_ascii(bytes, i, len);
+    if (i == len) {
+      return true;
+    }
+    // The second byte's range depends on the lead byte (RFC 3629, section 4); the rest
+    // are plain continuation bytes.
+    uint8_t lead = bytes[i];
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xBF;
+    uintptr_t tail;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      tail = 1;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      tail = 2;
+      if (lead == 0xE0) {
+        lo = 0xA0;
+      } else if (lead == 0xED) {
+        hi = 0x9F;
+      }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      tail = 3;
+      if (lead == 0xF0) {
+        lo = 0x90;
+      } else if (lead == 0xF4) {
+        hi = 0x8F;
+      }
+    } else {
+      return false;
+    }
+    if (len - i - 1 < tail || bytes[i + 1] < lo || bytes[i + 1] > hi) {
+      return false;
+    }
+    for (uintptr_t k = 2; k <= tail; k++) {
+      if ((bytes[i + k] & 0xC0) != 0x80) {
+        return false;
+      }
+    }
+    i += tail + 1;
+  }
+}
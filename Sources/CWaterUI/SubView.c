@@ -0,0 +1,77 @@
+// Native-side SubView helpers. See include/waterui_subview.h.
+
+#include "waterui_subview.h"
+
+// Children are handed to `measure_many` in chunks of this size so that the
+// gather buffers can live on the stack.
+#define WUI_MEASURE_CHUNK 64
+
+typedef struct MeasureChunk {
+  void *contexts[WUI_MEASURE_CHUNK];
+  struct WuiProposalSize proposals[WUI_MEASURE_CHUNK];
+  struct WuiSize sizes[WUI_MEASURE_CHUNK];
+  uintptr_t targets[WUI_MEASURE_CHUNK];
+  uintptr_t len;
+} MeasureChunk;
+
+static void flush_chunk(MeasureChunk *chunk,
+                        struct WuiSize *out_sizes,
+                        const struct WuiSubViewBatchVTable *batch) {
+  if (chunk->len == 0) {
+    return;
+  }
+  batch->measure_many(chunk->contexts, chunk->proposals, chunk->sizes, chunk->len);
+  for (uintptr_t i = 0; i < chunk->len; i++) {
+    out_sizes[chunk->targets[i]] = chunk->sizes[i];
+  }
+  chunk->len = 0;
+}
+
+static void measure_children(const struct WuiSubView *children,
+                             uintptr_t len,
+                             const struct WuiProposalSize *proposals,
+                             struct WuiProposalSize uniform,
+                             struct WuiSize *out_sizes,
+                             const struct WuiSubViewBatchVTable *batch) {
+  bool batched = batch != NULL && batch->measure != NULL && batch->measure_many != NULL;
+  MeasureChunk chunk;
+  chunk.len = 0;
+
+  for (uintptr_t i = 0; i < len; i++) {
+    const struct WuiSubView *child = &children[i];
+    struct WuiProposalSize proposal = proposals != NULL ? proposals[i] : uniform;
+
+    if (batched && child->vtable.measure == batch->measure) {
+      chunk.contexts[chunk.len] = child->context;
+      chunk.proposals[chunk.len] = proposal;
+      chunk.targets[chunk.len] = i;
+      chunk.len++;
+      if (chunk.len == WUI_MEASURE_CHUNK) {
+        flush_chunk(&chunk, out_sizes, batch);
+      }
+    } else {
+      out_sizes[i] = child->vtable.measure(child->context, proposal);
+    }
+  }
+
+  if (batched) {
+    flush_chunk(&chunk, out_sizes, batch);
+  }
+}
+
+void waterui_subviews_measure_many(const struct WuiSubView *children,
+                                   uintptr_t len,
+                                   const struct WuiProposalSize *proposals,
+                                   struct WuiSize *out_sizes,
+                                   const struct WuiSubViewBatchVTable *batch) {
+  struct WuiProposalSize unused = {0, 0};
+  measure_children(children, len, proposals, unused, out_sizes, batch);
+}
+
+void waterui_subviews_measure_uniform(const struct WuiSubView *children,
+                                      uintptr_t len,
+                                      struct WuiProposalSize proposal,
+                                      struct WuiSize *out_sizes,
+                                      const struct WuiSubViewBatchVTable *batch) {
+  measure_children(children, len, NULL, proposal, out_sizes, batch);
+}
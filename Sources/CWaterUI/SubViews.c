@@ -0,0 +1,253 @@
+// Persistent SubView sets. See include/waterui_subview.h.
+
+#include <string.h>
+
+#include "LayoutStatsRecorder.h"
+#include "MeasurePool.h"
+#include "waterui_arena.h"
+
+struct WuiSubViews {
+  // `entries[i]` is the cache-backed subview handed to layouts; it borrows `caches[i]`.
+  struct WuiSubView *entries;
+  struct WuiMeasureCache **caches;
+  // Entry indices by descending priority, ties in index order. Rebuilt lazily after the
+  // set is resized or an entry's priority changes.
+  uint32_t *order;
+  bool order_valid;
+  uintptr_t len;
+  uintptr_t capacity;
+  // Borrowed; NULL unless the owner opted in to parallel measuring.
+  struct WuiMeasurePool *pool;
+};
+
+static struct WuiSize empty_measure(void *context, struct WuiProposalSize proposal) {
+  (void)context;
+  (void)proposal;
+  struct WuiSize size = {0, 0};
+  return size;
+}
+
+static void empty_drop(void *context) {
+  (void)context;
+}
+
+static struct WuiSubView empty_entry(void) {
+  struct WuiSubView entry;
+  entry.context = NULL;
+  entry.vtable.measure = empty_measure;
+  entry.vtable.drop = empty_drop;
+  entry.stretch_axis = WuiStretchAxis_None;
+  entry.priority = 0;
+  return entry;
+}
+
+static bool reserve(struct WuiSubViews *subviews, uintptr_t capacity) {
+  if (capacity <= subviews->capacity) {
+    return true;
+  }
+  uintptr_t grown = subviews->capacity * 2;
+  if (grown < capacity) {
+    grown = capacity;
+  }
+  // Counted once per growth, which reallocates each of the parallel arrays below.
+  wui_stats_allocation();
+  struct WuiSubView *entries = realloc(subviews->entries, grown * sizeof(struct WuiSubView));
+  if (entries == NULL) {
+    return false;
+  }
+  subviews->entries = entries;
+  struct WuiMeasureCache **caches = realloc(subviews->caches, grown * sizeof(struct WuiMeasureCache *));
+  if (caches == NULL) {
+    return false;
+  }
+  subviews->caches = caches;
+  uint32_t *order = realloc(subviews->order, grown * sizeof(uint32_t));
+  if (order == NULL) {
+    return false;
+  }
+  subviews->order = order;
+  subviews->capacity = grown;
+  return true;
+}
+
+struct WuiSubViews *waterui_subviews_new(uintptr_t capacity) {
+  struct WuiSubViews *subviews = calloc(1, sizeof(struct WuiSubViews));
+  if (subviews == NULL) {
+    return NULL;
+  }
+  if (!reserve(subviews, capacity)) {
+    waterui_subviews_drop(subviews);
+    return NULL;
+  }
+  return subviews;
+}
+
+void waterui_subviews_drop(struct WuiSubViews *subviews) {
+  if (subviews == NULL) {
+    return;
+  }
+  for (uintptr_t i = 0; i < subviews->len; i++) {
+    waterui_measure_cache_drop(subviews->caches[i]);
+  }
+  free(subviews->entries);
+  free(subviews->caches);
+  free(subviews->order);
+  free(subviews);
+}
+
+uintptr_t waterui_subviews_len(const struct WuiSubViews *subviews) {
+  return subviews->len;
+}
+
+void waterui_subviews_resize(struct WuiSubViews *subviews, uintptr_t len) {
+  for (uintptr_t i = len; i < subviews->len; i++) {
+    waterui_measure_cache_drop(subviews->caches[i]);
+  }
+  if (len > subviews->len) {
+    if (!reserve(subviews, len)) {
+      return;
+    }
+    for (uintptr_t i = subviews->len; i < len; i++) {
+      subviews->entries[i] = empty_entry();
+      subviews->caches[i] = NULL;
+    }
+  }
+  if (len != subviews->len) {
+    subviews->order_valid = false;
+  }
+  subviews->len = len;
+}
+
+void waterui_subviews_update(struct WuiSubViews *subviews,
+                             uintptr_t index,
+                             struct WuiSubView inner,
+                             const struct WuiSubViewBatchVTable *inner_batch,
+                             uint32_t flags) {
+  if (index >= subviews->len) {
+    if (inner.vtable.drop != NULL) {
+      inner.vtable.drop(inner.context);
+    }
+    return;
+  }
+  if (inner.priority != subviews->entries[index].priority) {
+    subviews->order_valid = false;
+  }
+  waterui_measure_cache_drop(subviews->caches[index]);
+  struct WuiMeasureCache *cache = waterui_measure_cache_new(inner, inner_batch, flags);
+  if (cache == NULL && inner.vtable.drop != NULL) {
+    // The set owns `inner` either way; without a cache to hold it, it goes now.
+    inner.vtable.drop(inner.context);
+  }
+  subviews->caches[index] = cache;
+  subviews->entries[index] = cache != NULL ? waterui_measure_cache_subview(cache) : empty_entry();
+}
+
+uint32_t waterui_subviews_flags(const struct WuiSubViews *subviews, uintptr_t index) {
+  if (index >= subviews->len || subviews->caches[index] == NULL) {
+    return WuiSubViewFlags_None;
+  }
+  return waterui_measure_cache_flags(subviews->caches[index]);
+}
+
+void waterui_subviews_set_measure_pool(struct WuiSubViews *subviews, struct WuiMeasurePool *pool) {
+  subviews->pool = pool;
+}
+
+void waterui_subviews_prefetch(struct WuiSubViews *subviews, struct WuiProposalSize proposal) {
+  if (subviews->pool == NULL) {
+    return;
+  }
+  // Higher-priority children are measured first by layouts; warm them first too.
+  const uint32_t *order = waterui_subviews_priority_order(subviews);
+  wui_measure_pool_prefetch(subviews->pool, subviews->caches, order, subviews->len, proposal);
+}
+
+// Stable merge sort of `order` by descending priority, using `scratch` of the same length.
+static void sort_by_priority(uint32_t *order, uint32_t *scratch, uintptr_t len, const struct WuiSubView *entries) {
+  for (uintptr_t width = 1; width < len; width *= 2) {
+    for (uintptr_t lo = 0; lo < len; lo += 2 * width) {
+      uintptr_t mid = lo + width < len ? lo + width : len;
+      uintptr_t hi = lo + 2 * width < len ? lo + 2 * width : len;
+      uintptr_t a = lo;
+      uintptr_t b = mid;
+      uintptr_t out = lo;
+      while (a < mid && b < hi) {
+        // Taking from the left run on ties keeps the sort stable.
+        if (entries[order[b]].priority > entries[order[a]].priority) {
+          scratch[out++] = order[b++];
+        } else {
+          scratch[out++] = order[a++];
+        }
+      }
+      while (a < mid) {
+        scratch[out++] = order[a++];
+      }
+      while (b < hi) {
+        scratch[out++] = order[b++];
+      }
+    }
+    memcpy(order, scratch, len * sizeof(uint32_t));
+  }
+}
+
+const uint32_t *waterui_subviews_priority_order(struct WuiSubViews *subviews) {
+  if (subviews->order_valid) {
+    return subviews->order;
+  }
+  bool uniform = true;
+  for (uintptr_t i = 0; i < subviews->len; i++) {
+    subviews->order[i] = (uint32_t)i;
+    uniform = uniform && subviews->entries[i].priority == subviews->entries[0].priority;
+  }
+  // The common case: no child asked for a priority, so index order already is the answer.
+  if (!uniform) {
+    // Inside a layout pass the scratch comes from the frame arena instead of the heap.
+    uint32_t *scratch = waterui_frame_arena_alloc(subviews->len * sizeof(uint32_t), _Alignof(uint32_t));
+    bool heap = scratch == NULL;
+    if (heap) {
+      scratch = malloc(subviews->len * sizeof(uint32_t));
+      if (scratch == NULL) {
+        return subviews->order;
+      }
+      wui_stats_allocation();
+    }
+    sort_by_priority(subviews->order, scratch, subviews->len, subviews->entries);
+    if (heap) {
+      free(scratch);
+    }
+  }
+  subviews->order_valid = true;
+  return subviews->order;
+}
+
+struct WuiMeasureCache *waterui_subviews_cache(struct WuiSubViews *subviews, uintptr_t index) {
+  return index < subviews->len ? subviews->caches[index] : NULL;
+}
+
+void waterui_subviews_invalidate(struct WuiSubViews *subviews) {
+  for (uintptr_t i = 0; i < subviews->len; i++) {
+    if (subviews->caches[i] != NULL) {
+      waterui_measure_cache_invalidate(subviews->caches[i]);
+    }
+  }
+}
+
+static void borrowed_array_drop(void *data) {
+  (void)data;
+}
+
+static struct WuiArraySlice_WuiSubView borrowed_array_slice(const void *data) {
+  const struct WuiSubViews *subviews = data;
+  struct WuiArraySlice_WuiSubView slice;
+  slice.head = subviews->entries;
+  slice.len = subviews->len;
+  return slice;
+}
+
+struct WuiArray_WuiSubView waterui_subviews_array(struct WuiSubViews *subviews) {
+  struct WuiArray_WuiSubView array;
+  array.data = subviews;
+  array.vtable.drop = borrowed_array_drop;
+  array.vtable.slice = borrowed_array_slice;
+  return array;
+}
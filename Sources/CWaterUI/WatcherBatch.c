@@ -0,0 +1,129 @@
+// Watcher notification batches. See include/waterui_batch.h.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "MainThread.h"
+#include "waterui_batch.h"
+
+// Main-thread state, unlocked; the watchers this holds back are delivered there.
+static struct {
+  uint32_t depth;
+  WuiDeferredCall *calls;
+  uintptr_t len;
+  uintptr_t capacity;
+  // Open-addressed map from key to index in `calls` + 1; 0 marks an empty slot. Sized to
+  // twice `capacity`, a power of two.
+  uintptr_t *slots;
+} batch;
+
+static uintptr_t slot_of(const void *key, uintptr_t mask) {
+  uintptr_t hash = (uintptr_t)key;
+  hash ^= hash >> 17;
+  hash *= (uintptr_t)0x9E3779B97F4A7C15ull;
+  return (hash ^ (hash >> 29)) & mask;
+}
+
+static uintptr_t *find_slot(const void *key) {
+  uintptr_t mask = batch.capacity * 2 - 1;
+  uintptr_t i = slot_of(key, mask);
+  while (batch.slots[i] != 0 && batch.calls[batch.slots[i] - 1].key != key) {
+    i = (i + 1) & mask;
+  }
+  return &batch.slots[i];
+}
+
+static bool grow(void) {
+  uintptr_t capacity = batch.capacity > 0 ? batch.capacity * 2 : 32;
+  WuiDeferredCall *calls = realloc(batch.calls, capacity * sizeof(WuiDeferredCall));
+  if (calls == NULL) {
+    return false;
+  }
+  batch.calls = calls;
+  uintptr_t *slots = calloc(capacity * 2, sizeof(uintptr_t));
+  if (slots == NULL) {
+    return false;
+  }
+  free(batch.slots);
+  batch.slots = slots;
+  batch.capacity = capacity;
+  for (uintptr_t i = 0; i < batch.len; i++) {
+    if (batch.calls[i].key != NULL) {
+      *find_slot(batch.calls[i].key) = i + 1;
+    }
+  }
+  return true;
+}
+
+void waterui_begin_batch(void) {
+  wui_assert_main_thread();
+  batch.depth++;
+}
+
+void waterui_commit_batch(void) {
+  wui_assert_main_thread();
+  if (batch.depth == 0 || --batch.depth > 0) {
+    return;
+  }
+  // Deliveries run with the batch closed, so anything they notify goes out right away. One
+  // that opens and commits a batch of its own must not see these calls again, so the
+  // pending list is detached first and only taken back if nothing replaced it.
+  WuiDeferredCall *calls = batch.calls;
+  uintptr_t *slots = batch.slots;
+  uintptr_t len = batch.len;
+  uintptr_t capacity = batch.capacity;
+  batch.calls = NULL;
+  batch.slots = NULL;
+  batch.len = 0;
+  batch.capacity = 0;
+  for (uintptr_t i = 0; i < len; i++) {
+    calls[i].call(calls[i].context);
+    if (calls[i].drop != NULL) {
+      calls[i].drop(calls[i].context);
+    }
+  }
+  if (batch.capacity == 0 && calls != NULL) {
+    for (uintptr_t i = 0; i < capacity * 2; i++) {
+      slots[i] = 0;
+    }
+    free(batch.calls);
+    batch.calls = calls;
+    batch.slots = slots;
+    batch.capacity = capacity;
+  } else {
+    free(calls);
+    free(slots);
+  }
+}
+
+bool waterui_batch_is_open(void) {
+  wui_assert_main_thread();
+  return batch.depth > 0;
+}
+
+bool waterui_batch_defer(WuiDeferredCall call) {
+  wui_assert_main_thread();
+  if (batch.depth == 0) {
+    return false;
+  }
+  if (call.key != NULL && batch.capacity > 0) {
+    uintptr_t *slot = find_slot(call.key);
+    if (*slot != 0) {
+      WuiDeferredCall *pending = &batch.calls[*slot - 1];
+      if (pending->drop != NULL) {
+        pending->drop(pending->context);
+      }
+      *pending = call;
+      return true;
+    }
+  }
+  if (batch.len == batch.capacity && !grow()) {
+    return false;
+  }
+  batch.calls[batch.len] = call;
+  batch.len++;
+  if (call.key != NULL) {
+    *find_slot(call.key) = batch.len;
+  }
+  return true;
+}
@@ -0,0 +1,17 @@
+// Watcher metadata by value. See include/waterui_watcher.h.
+
+#include "waterui_watcher.h"
+
+struct WuiWatcherInfo waterui_watcher_metadata_take(struct WuiWatcherMetadata *metadata) {
+  struct WuiWatcherInfo info = {0};
+  info.animation.tag = WuiAnimation_None;
+  if (metadata == NULL) {
+    return info;
+  }
+  info.animation = waterui_get_animation(metadata);
+  waterui_drop_watcher_metadata(metadata);
+  if (info.animation.tag != WuiAnimation_None) {
+    info.flags |= WuiWatcherFlags_Animated;
+  }
+  return info;
+}
@@ -0,0 +1,88 @@
+// Generation-checked slot table for watcher contexts. See include/waterui_watcher.h.
+
+#include <stdlib.h>
+
+#include "MainThread.h"
+#include "waterui_watcher.h"
+
+// A handle packs the slot index into the low bits and the slot's generation above them.
+#define WUI_SLOT_INDEX_MASK (((uintptr_t)1 << WUI_SLOT_INDEX_BITS) - 1)
+#define WUI_SLOT_GENERATION_MAX (UINTPTR_MAX >> WUI_SLOT_INDEX_BITS)
+#define WUI_SLOT_NONE UINT32_MAX
+
+typedef struct Slot {
+  // Starts at 1 so no handle is 0; even while free, odd while occupied.
+  uintptr_t generation;
+  uint32_t next_free;
+} Slot;
+
+// Only the main thread touches the table, so nothing is locked.
+static struct {
+  Slot *slots;
+  uint32_t len;
+  uint32_t capacity;
+  uint32_t free;
+  uintptr_t count;
+} table = {NULL, 0, 0, WUI_SLOT_NONE, 0};
+
+static intptr_t resolve(WuiSlotHandle handle) {
+  uintptr_t index = handle & WUI_SLOT_INDEX_MASK;
+  if (index >= table.len || table.slots[index].generation != handle >> WUI_SLOT_INDEX_BITS) {
+    return -1;
+  }
+  return (intptr_t)index;
+}
+
+WuiSlotHandle waterui_slot_insert(void) {
+  wui_assert_main_thread();
+  uint32_t index = table.free;
+  // Slots whose generation is used up are retired rather than recycled.
+  while (index != WUI_SLOT_NONE && table.slots[index].generation >= WUI_SLOT_GENERATION_MAX - 1) {
+    index = table.free = table.slots[index].next_free;
+  }
+  if (index != WUI_SLOT_NONE) {
+    table.free = table.slots[index].next_free;
+  } else {
+    if (table.len == table.capacity) {
+      uint32_t capacity = table.capacity > 0 ? table.capacity * 2 : 256;
+      Slot *slots = NULL;
+      if (table.capacity <= (WUI_SLOT_INDEX_MASK >> 1)) {
+        slots = realloc(table.slots, capacity * sizeof(Slot));
+      }
+      if (slots == NULL) {
+        return 0;
+      }
+      table.slots = slots;
+      table.capacity = capacity;
+    }
+    index = table.len++;
+    table.slots[index].generation = 0;
+  }
+  Slot *slot = &table.slots[index];
+  slot->generation++;
+  slot->next_free = WUI_SLOT_NONE;
+  table.count++;
+  return (slot->generation << WUI_SLOT_INDEX_BITS) | index;
+}
+
+intptr_t waterui_slot_index(WuiSlotHandle handle) {
+  return resolve(handle);
+}
+
+intptr_t waterui_slot_remove(WuiSlotHandle handle) {
+  wui_assert_main_thread();
+  intptr_t index = resolve(handle);
+  if (index < 0) {
+    return -1;
+  }
+  Slot *slot = &table.slots[index];
+  slot->generation++;
+  slot->next_free = table.free;
+  table.free = (uint32_t)index;
+  table.count--;
+  return index;
+}
+
+uintptr_t waterui_slot_count(void) {
+  return table.count;
+}
@@ -0,0 +1,21 @@
+// Umbrella header for the CWaterUI module.
+//
+// `waterui.h` is generated by the Rust crate and copied in by CI; the other
+// headers are native-side helpers implemented in this target.
+
+#ifndef CWATERUI_H
+#define CWATERUI_H
+
+#include "waterui_ffi.h"
+#include "waterui_arena.h"
+#include "waterui_array.h"
+#include "waterui_batch.h"
+#include "waterui_str.h"
+#include "waterui_subview.h"
+#include "waterui_watcher.h"
+#include "waterui_layout.h"
+#include "waterui_layout_trace.h"
+#include "waterui_layout_tree.h"
+#include "waterui_geometry.h"
+
+#endif /* CWATERUI_H */
@@ -0,0 +1,163 @@
+// C++ ownership and view helpers over the C ABI. Not part of the Swift module.
+
+#ifndef WATERUI_HPP
+#define WATERUI_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "CWaterUI.h"
+
+namespace wui {
+
+/**
+ * Move-only owner of a `T *` that is released with `Drop`, like `std::unique_ptr` with a
+ * stateless deleter. It is exactly one pointer wide, and moving it or letting it go out of
+ * scope compiles down to the raw pointer copy and the `Drop` call.
+ */
+template <typename T, void (*Drop)(T *)>
+class owned {
+ public:
+  constexpr owned() noexcept = default;
+  constexpr explicit owned(T *ptr) noexcept : ptr_(ptr) {}
+  owned(owned &&other) noexcept : ptr_(other.release()) {}
+  owned &operator=(owned &&other) noexcept {
+    reset(other.release());
+    return *this;
+  }
+  owned(const owned &) = delete;
+  owned &operator=(const owned &) = delete;
+  ~owned() { reset(); }
+
+  constexpr T *get() const noexcept { return ptr_; }
+  constexpr T *operator->() const noexcept { return ptr_; }
+  constexpr explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+  /** Gives up ownership without dropping, for handing the pointer back to C. */
+  T *release() noexcept { return std::exchange(ptr_, nullptr); }
+
+  void reset(T *ptr = nullptr) noexcept {
+    T *old = std::exchange(ptr_, ptr);
+    if (old != nullptr) {
+      Drop(old);
+    }
+  }
+
+ private:
+  T *ptr_ = nullptr;
+};
+
+using env = owned<WuiEnv, waterui_drop_env>;
+using any_view = owned<WuiAnyView, waterui_drop_anyview>;
+using layout = owned<WuiLayout, waterui_drop_layout>;
+using binding_str = owned<WuiBinding_Str, waterui_drop_binding_str>;
+using computed_str = owned<WuiComputed_Str, waterui_drop_computed_str>;
+using subviews = owned<WuiSubViews, waterui_subviews_drop>;
+using measure_cache = owned<WuiMeasureCache, waterui_measure_cache_drop>;
+using measure_pool = owned<WuiMeasurePool, waterui_measure_pool_drop>;
+using layout_node = owned<WuiLayoutNode, waterui_layout_node_drop>;
+using layout_tree = owned<WuiLayoutTree, waterui_layout_tree_drop>;
+
+/** The element type of a `WuiArray_*`, taken from its slice. */
+template <typename Array>
+using array_element_t =
+    std::remove_pointer_t<decltype(std::declval<const Array &>().vtable.slice(nullptr).head)>;
+
+/**
+ * Non-owning view of the elements of any `WuiArray_*`.
+ *
+ * Constructing one makes the single `vtable.slice` call; iterating is a plain pointer walk.
+ * The view is valid until the array is dropped.
+ */
+template <typename T>
+class array_view {
+ public:
+  using value_type = T;
+  using iterator = const T *;
+
+  constexpr array_view() noexcept = default;
+  constexpr array_view(const T *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  template <typename Array, typename = std::enable_if_t<std::is_same_v<array_element_t<Array>, T>>>
+  explicit array_view(const Array &array) noexcept {
+    auto slice = array.vtable.slice(array.data);
+    data_ = slice.head;
+    size_ = slice.len;
+  }
+
+  constexpr const T *data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr const T &operator[](std::size_t index) const noexcept { return data_[index]; }
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+ private:
+  const T *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+template <typename Array>
+array_view(const Array &) -> array_view<array_element_t<Array>>;
+
+/**
+ * Move-only owner of any `WuiArray_*`, dropped through its vtable.
+ */
+template <typename Array>
+class owned_array {
+ public:
+  explicit owned_array(Array array) noexcept : array_(array), live_(true) {}
+  owned_array(owned_array &&other) noexcept : array_(other.array_), live_(std::exchange(other.live_, false)) {}
+  owned_array &operator=(owned_array &&other) noexcept {
+    if (this != &other) {
+      reset();
+      array_ = other.array_;
+      live_ = std::exchange(other.live_, false);
+    }
+    return *this;
+  }
+  owned_array(const owned_array &) = delete;
+  owned_array &operator=(const owned_array &) = delete;
+  ~owned_array() { reset(); }
+
+  array_view<array_element_t<Array>> view() const noexcept {
+    return live_ ? array_view<array_element_t<Array>>(array_) : array_view<array_element_t<Array>>();
+  }
+
+  /** Gives up ownership without dropping, for handing the array back to C. */
+  Array release() noexcept {
+    live_ = false;
+    return array_;
+  }
+
+ private:
+  void reset() noexcept {
+    if (std::exchange(live_, false)) {
+      array_.vtable.drop(array_.data);
+    }
+  }
+
+  Array array_;
+  bool live_;
+};
+
+/**
+ * Returns the UTF-8 bytes of `str` without copying. Valid until `str` is dropped.
+ */
+inline std::string_view view(const WuiStr &str) noexcept {
+  auto slice = str._0.vtable.slice(str._0.data);
+  return std::string_view(reinterpret_cast<const char *>(slice.head), slice.len);
+}
+
+/**
+ * Creates an owned `WuiStr` holding a copy of `text`.
+ */
+inline WuiStr make_str(std::string_view text) noexcept {
+  return waterui_str_new(reinterpret_cast<const uint8_t *>(text.data()), text.size());
+}
+
+}  // namespace wui
+
+#endif /* WATERUI_HPP */
@@ -0,0 +1,41 @@
+// Per-frame scratch memory for transient buffers.
+
+#ifndef WATERUI_ARENA_H
+#define WATERUI_ARENA_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Opens a frame on the calling thread's arena.
+ *
+ * Frames nest; memory handed out by `waterui_frame_arena_alloc` stays valid until the
+ * outermost frame is closed. Each thread has its own arena, so no locking is involved;
+ * a thread's blocks are freed when it exits.
+ */
+void waterui_frame_arena_begin(void);
+
+/**
+ * Closes the innermost frame. Closing the outermost one releases everything allocated
+ * since it was opened in one step and keeps the memory for the next frame.
+ */
+void waterui_frame_arena_end(void);
+
+/**
+ * Returns `size` bytes aligned to `align`, a power of two, from the current frame.
+ *
+ * Allocation is a pointer bump; when a block runs out another, larger one is chained on,
+ * and the blocks are merged into one when the frame closes so that steady-state frames
+ * use a single block. Returns NULL if no frame is open or memory is exhausted; callers
+ * fall back to the heap.
+ */
+void *waterui_frame_arena_alloc(uintptr_t size, uintptr_t align);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_ARENA_H */
@@ -0,0 +1,75 @@
+// Native-side WuiArray storage and accessors.
+
+#ifndef WATERUI_ARRAY_H
+#define WATERUI_ARRAY_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates an owned array holding a copy of `len` elements of `element_size` bytes each.
+ *
+ * The elements live in the same allocation as the array's header, so building one costs a
+ * single allocation and no per-array vtable state; empty arrays share a static block and
+ * allocate nothing. Elements are copied bitwise and must not need a destructor, and their
+ * alignment must not exceed `waterui_array_copy_alignment`. Zero-sized elements keep their
+ * count. Aborts if memory is exhausted, like the Rust and Swift allocators do.
+ */
+struct WuiArray waterui_array_copy(const void *elements, uintptr_t len, uintptr_t element_size);
+
+/**
+ * Returns the alignment `waterui_array_copy` guarantees for its elements.
+ */
+uintptr_t waterui_array_copy_alignment(void);
+
+/**
+ * Returns whether `array` was created by `waterui_array_copy`.
+ */
+bool waterui_array_is_inline(const struct WuiArray *array);
+
+/**
+ * Returns the elements of any array.
+ *
+ * Arrays created by `waterui_array_copy` are read directly; others go through
+ * `vtable.slice`. Arrays are immutable once they cross the FFI, so the result stays valid
+ * until the array is dropped and can be kept instead of asking again.
+ */
+struct WuiArraySlice waterui_array_slice(const struct WuiArray *array);
+
+/**
+ * Turns `bytes` into a shared buffer, taking ownership of it.
+ *
+ * The bytes are not copied: the original array is kept alive behind an atomic reference
+ * count and dropped when the last handle to it goes. Handles are ordinary byte arrays, so
+ * they can cross the FFI in either direction, and are safe to retain and drop from any
+ * thread. Returns `bytes` unchanged if it already is shared. Aborts if memory is exhausted.
+ */
+struct WuiArray_u8 waterui_bytes_share(struct WuiArray_u8 bytes);
+
+/**
+ * Returns whether `bytes` is a handle created by the functions below.
+ */
+bool waterui_bytes_is_shared(const struct WuiArray_u8 *bytes);
+
+/**
+ * Returns another handle to the buffer behind `bytes`, which stays owned by the caller.
+ *
+ * For a shared buffer this is an atomic increment; any other array is copied.
+ */
+struct WuiArray_u8 waterui_bytes_retain(const struct WuiArray_u8 *bytes);
+
+/**
+ * Returns a handle to `len` bytes of `bytes` starting at `start`, clamped to its end.
+ *
+ * Slices of a shared buffer reference it without copying; any other array is copied.
+ */
+struct WuiArray_u8 waterui_bytes_slice(const struct WuiArray_u8 *bytes, uintptr_t start, uintptr_t len);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_ARRAY_H */
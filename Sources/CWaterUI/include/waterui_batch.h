@@ -0,0 +1,56 @@
+// Transactions that coalesce watcher notifications.
+
+#ifndef WATERUI_BATCH_H
+#define WATERUI_BATCH_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A notification held back by an open batch. `call` delivers it and `drop` releases
+ * `context` afterwards, or instead if a later notification for the same key supersedes it.
+ */
+typedef struct WuiDeferredCall {
+  const void *key;
+  void *context;
+  void (*call)(void *context);
+  void (*drop)(void *context);
+} WuiDeferredCall;
+
+/**
+ * Opens a batch. Batches nest; watcher notifications are held back until the outermost one
+ * is committed. Must be called on the main thread, where watchers are delivered, as must
+ * every other function here; debug builds assert it.
+ */
+void waterui_begin_batch(void);
+
+/**
+ * Closes the innermost batch. Committing the outermost one delivers every held-back
+ * notification once, in the order their keys were first notified.
+ */
+void waterui_commit_batch(void);
+
+/**
+ * Returns whether a batch is open.
+ */
+bool waterui_batch_is_open(void);
+
+/**
+ * Holds back `call` until the batch is committed, taking ownership of its context.
+ *
+ * A pending call with the same non-NULL `key`, typically the watcher's context, is
+ * superseded: its context is dropped undelivered and `call` takes its place, so a watcher
+ * notified several times in one batch only sees the latest value. Calls with a NULL key
+ * are all delivered. Returns false, leaving `call` untouched, if no batch is open or
+ * memory is exhausted; the caller then delivers it immediately.
+ */
+bool waterui_batch_defer(WuiDeferredCall call);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_BATCH_H */
@@ -0,0 +1,9 @@
+// Include guard around the generated header, which ships without one.
+// Hand-written native headers include this instead of "waterui.h" directly.
+
+#ifndef WATERUI_FFI_H
+#define WATERUI_FFI_H
+
+#include "waterui.h"
+
+#endif /* WATERUI_FFI_H */
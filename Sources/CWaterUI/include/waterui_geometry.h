@@ -0,0 +1,37 @@
+// Geometry kernels for the platform layers.
+
+#ifndef WATERUI_GEOMETRY_H
+#define WATERUI_GEOMETRY_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A rect in double precision, laid out like a 64-bit `CGRect`.
+ */
+typedef struct WuiRect64 {
+  double x;
+  double y;
+  double width;
+  double height;
+} WuiRect64;
+
+/**
+ * Widens `len` rects to double precision and snaps them to the pixel grid of a display
+ * with `scale` pixels per point, writing the results to `out`.
+ *
+ * Both edges of each axis are rounded to the nearest pixel (ties to even) and the size is
+ * derived from the snapped edges, so adjacent rects stay adjacent. A `scale` that is not
+ * positive disables snapping. Rects with non-finite or out-of-range coordinates are only
+ * widened. `rects` and `out` must not overlap.
+ */
+void waterui_rects_snap(const struct WuiRect *rects, uintptr_t len, double scale, struct WuiRect64 *out);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_GEOMETRY_H */
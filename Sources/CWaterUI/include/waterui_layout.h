@@ -0,0 +1,202 @@
+// Native-side layout driver built on the Rust layout entry points.
+
+#ifndef WATERUI_LAYOUT_H
+#define WATERUI_LAYOUT_H
+
+#include "waterui_ffi.h"
+#include "waterui_subview.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Calculates the size required by the layout for `proposal`.
+ *
+ * Equivalent to `waterui_layout_size_that_fits` over the set's children, routed through
+ * the native driver so the call is measured and recorded like every other.
+ */
+struct WuiSize waterui_layout_container_size(struct WuiLayout *layout,
+                                             struct WuiProposalSize proposal,
+                                             struct WuiSubViews *subviews);
+
+/**
+ * Sizes the layout for `proposal` and places its children within `bounds` in one call.
+ *
+ * Both negotiation steps run against the same subview set, so every child measurement
+ * made while sizing is answered from the measure caches while placing. The child rects
+ * are written to `out_rects`, which the caller must drop.
+ *
+ * # Safety
+ *
+ * - `layout` and `subviews` must be valid.
+ * - `out_rects` must point to writable storage for one `WuiArray_WuiRect`.
+ */
+struct WuiSize waterui_layout_size_and_place(struct WuiLayout *layout,
+                                             struct WuiProposalSize proposal,
+                                             struct WuiRect bounds,
+                                             struct WuiSubViews *subviews,
+                                             struct WuiArray_WuiRect *out_rects);
+
+/**
+ * Places children within `bounds`, writing the rects into a caller-owned buffer.
+ *
+ * At most `capacity` rects are written to `out_rects`. Returns the number of rects the
+ * layout produced, which is one per child; a result larger than `capacity` means the
+ * output was truncated. Sizing the buffer to `waterui_subviews_len` avoids that.
+ *
+ * This saves the caller's copy, not the Rust allocation: `waterui_layout_place` still
+ * returns an owned array, which is copied into `out_rects` and dropped, so every call
+ * allocates once on the Rust side.
+ *
+ * # Safety
+ *
+ * - `layout` and `subviews` must be valid.
+ * - `out_rects` must point to writable storage for `capacity` rects.
+ */
+uintptr_t waterui_layout_place_into(struct WuiLayout *layout,
+                                    struct WuiRect bounds,
+                                    struct WuiSubViews *subviews,
+                                    struct WuiRect *out_rects,
+                                    uintptr_t capacity);
+
+/**
+ * Like `waterui_layout_size_and_place`, but writes the rects into a caller-owned buffer
+ * as `waterui_layout_place_into` does. The number of rects produced is stored in
+ * `out_len`.
+ */
+struct WuiSize waterui_layout_size_and_place_into(struct WuiLayout *layout,
+                                                  struct WuiProposalSize proposal,
+                                                  struct WuiRect bounds,
+                                                  struct WuiSubViews *subviews,
+                                                  struct WuiRect *out_rects,
+                                                  uintptr_t capacity,
+                                                  uintptr_t *out_len);
+
+/**
+ * Cost counters for layout negotiation.
+ *
+ * The driver updates them around every Rust layout call it makes and every measure
+ * callback those calls make into the native side. A pass is one outermost layout call,
+ * including everything nested containers do while their parent measures them;
+ * `waterui_layout_size_and_place` and `waterui_layout_size_and_place_into` count as one
+ * pass. Counters are updated atomically and pass nesting is tracked per thread, so
+ * layouts running on different threads do not disturb each other. Measurements
+ * prefetched on a measure pool's workers are not included.
+ */
+typedef struct WuiLayoutStats {
+  /**
+   * Outermost layout calls, or combined size-and-place calls.
+   */
+  uint64_t passes;
+  uint64_t size_calls;
+  uint64_t place_calls;
+  /**
+   * Measure callbacks made by Rust layouts, cached or not.
+   */
+  uint64_t measure_callbacks;
+  /**
+   * Measure callbacks made during the most recent pass, and the most made by any pass.
+   */
+  uint64_t last_pass_measure_callbacks;
+  uint64_t max_pass_measure_callbacks;
+  /**
+   * Deepest nesting of layout calls, 1 for a container without nested containers.
+   */
+  uint32_t max_depth;
+  /**
+   * Time spent inside Rust layout code, excluding the measure callbacks it made.
+   */
+  uint64_t rust_ns;
+  /**
+   * Time spent in native measure callbacks, excluding nested Rust layout calls.
+   */
+  uint64_t native_measure_ns;
+  /**
+   * Heap allocations made for layout: measure caches, growth of subview sets and layout
+   * trees, and the rect arrays returned by Rust place calls.
+   */
+  uint64_t allocations;
+} WuiLayoutStats;
+
+/**
+ * Returns the counters accumulated since the last reset.
+ */
+struct WuiLayoutStats waterui_layout_stats(void);
+
+/**
+ * Resets every counter to zero.
+ */
+void waterui_layout_stats_reset(void);
+
+/**
+ * A node in the native mirror of the container hierarchy.
+ *
+ * Each container owns one node linked to the node of its nearest container ancestor.
+ * A node is dirty when its own negotiation must run again; ancestors of a dirty node are
+ * flagged as having a dirty descendant but keep their last placement. Clean nodes whose
+ * bounds and pixel scale did not change skip layout entirely.
+ */
+typedef struct WuiLayoutNode WuiLayoutNode;
+
+/**
+ * Creates a dirty, unparented node.
+ */
+struct WuiLayoutNode *waterui_layout_node_new(void);
+
+/**
+ * Drops the node, detaching it from its parent and orphaning its children.
+ */
+void waterui_layout_node_drop(struct WuiLayoutNode *node);
+
+/**
+ * Moves the node under `parent`, or detaches it when `parent` is NULL.
+ */
+void waterui_layout_node_set_parent(struct WuiLayoutNode *node, struct WuiLayoutNode *parent);
+
+/**
+ * Returns the parent node, or NULL.
+ */
+struct WuiLayoutNode *waterui_layout_node_parent(const struct WuiLayoutNode *node);
+
+/**
+ * Marks the node dirty and flags every ancestor as having a dirty descendant.
+ */
+void waterui_layout_node_mark_dirty(struct WuiLayoutNode *node);
+
+/**
+ * Reports that a child's content changed.
+ *
+ * Re-measures the child through `child_cache` with every proposal the node's layout used
+ * last pass. Only when a measured size changed is the node marked dirty; the result tells
+ * the caller whether the change must keep propagating upward. A NULL cache counts as a
+ * change.
+ */
+bool waterui_layout_node_child_changed(struct WuiLayoutNode *node, struct WuiMeasureCache *child_cache);
+
+/**
+ * Returns whether the node is dirty.
+ */
+bool waterui_layout_node_is_dirty(const struct WuiLayoutNode *node);
+
+/**
+ * Returns whether a descendant of the node is dirty.
+ */
+bool waterui_layout_node_has_dirty_descendant(const struct WuiLayoutNode *node);
+
+/**
+ * Returns whether the node must lay out within `bounds` at `scale` pixels per point: it is
+ * dirty, or its bounds or scale differ from the last completed layout.
+ */
+bool waterui_layout_node_needs_layout(const struct WuiLayoutNode *node, struct WuiRect bounds, float scale);
+
+/**
+ * Records a completed layout within `bounds` at `scale` and clears the node's dirty bits.
+ */
+void waterui_layout_node_did_layout(struct WuiLayoutNode *node, struct WuiRect bounds, float scale);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_LAYOUT_H */
@@ -0,0 +1,130 @@
+// Recording and offline replay of layout negotiation.
+
+#ifndef WATERUI_LAYOUT_TRACE_H
+#define WATERUI_LAYOUT_TRACE_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Trace format version written by the recorder.
+ *
+ * A trace is a 8-byte header (`"WUIT"`, `uint16_t` version, `uint16_t` byte-order mark)
+ * followed by records, each introduced by a one-byte `WuiLayoutTraceTag`. All values are
+ * stored in the recording host's native byte order; the mark is
+ * `WUI_LAYOUT_TRACE_BYTE_ORDER_MARK` as written by that host, so a reader on a host of
+ * the other byte order sees it swapped and rejects the trace.
+ *
+ * Layout ids are the addresses of the recorded layouts. An address freed during the
+ * recording can be reused by a later layout, so one id may stand for several layouts
+ * within a trace.
+ *
+ * - `SizeCall`: `uint64_t` layout id, proposal (2 x `float`), `uint32_t` child count,
+ *   then per child `uint8_t` stretch axis and `int32_t` priority.
+ * - `PlaceCall`: as `SizeCall`, with bounds (4 x `float`) in place of the proposal.
+ * - `Measure`: `uint32_t` child index, proposal (2 x `float`), size (2 x `float`).
+ * - `SizeResult`: size (2 x `float`).
+ * - `PlaceResult`: `uint32_t` rect count, then rects (4 x `float` each).
+ *
+ * A call is closed by its result record. Measures belong to the innermost open call and
+ * are written once the measure callback returns, so calls made by nested containers
+ * while measuring appear, fully closed, before the measure that triggered them.
+ */
+#define WUI_LAYOUT_TRACE_VERSION 2
+
+/**
+ * Byte-order mark stored in the trace header.
+ */
+#define WUI_LAYOUT_TRACE_BYTE_ORDER_MARK 0x0102
+
+typedef enum WuiLayoutTraceTag {
+  WuiLayoutTraceTag_SizeCall = 1,
+  WuiLayoutTraceTag_PlaceCall = 2,
+  WuiLayoutTraceTag_Measure = 3,
+  WuiLayoutTraceTag_SizeResult = 4,
+  WuiLayoutTraceTag_PlaceResult = 5,
+} WuiLayoutTraceTag;
+
+/**
+ * Starts recording every layout call made through the native layout driver to `path`.
+ *
+ * Returns false if the file could not be opened or a recording is already running.
+ */
+bool waterui_layout_trace_start(const char *path);
+
+/**
+ * Stops the current recording and flushes the file.
+ */
+void waterui_layout_trace_stop(void);
+
+/**
+ * Returns whether a recording is running.
+ */
+bool waterui_layout_trace_is_active(void);
+
+/**
+ * Layout entry points used to replay a trace.
+ *
+ * The signatures mirror `waterui_layout_size_that_fits` and `waterui_layout_place`, with
+ * the recorded layout id in place of the layout pointer, so a host that can construct
+ * layouts maps ids to real layouts. Children are stand-ins that answer `measure` from
+ * the recorded measurements.
+ */
+typedef struct WuiLayoutTraceReplayer {
+  void *context;
+  struct WuiSize (*size_that_fits)(void *context,
+                                   uint64_t layout_id,
+                                   struct WuiProposalSize proposal,
+                                   struct WuiArray_WuiSubView children);
+  struct WuiArray_WuiRect (*place)(void *context,
+                                   uint64_t layout_id,
+                                   struct WuiRect bounds,
+                                   struct WuiArray_WuiSubView children);
+} WuiLayoutTraceReplayer;
+
+/**
+ * Counters produced by a replay.
+ */
+typedef struct WuiLayoutTraceReplayStats {
+  uint64_t size_calls;
+  uint64_t place_calls;
+  /**
+   * Measure callbacks served by the stand-in children.
+   */
+  uint64_t measures;
+  /**
+   * Measures whose proposal was never recorded for that child; they answer zero.
+   */
+  uint64_t unmatched_measures;
+  /**
+   * Calls whose result differs from the recorded one.
+   */
+  uint64_t mismatched_results;
+  /**
+   * Monotonic time spent inside replayed calls.
+   */
+  uint64_t elapsed_ns;
+} WuiLayoutTraceReplayStats;
+
+/**
+ * Replays a trace held in memory.
+ *
+ * Calls are replayed innermost first, each against stand-in children. With a NULL
+ * `replayer` the recorded measurement stream is re-issued against the stand-ins and the
+ * recorded results are reused, which exercises and times the native side alone.
+ * Returns false if the trace is malformed; `out_stats` then covers the calls replayed so
+ * far.
+ */
+bool waterui_layout_trace_replay(const uint8_t *data,
+                                 uintptr_t len,
+                                 const struct WuiLayoutTraceReplayer *replayer,
+                                 struct WuiLayoutTraceReplayStats *out_stats);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_LAYOUT_TRACE_H */
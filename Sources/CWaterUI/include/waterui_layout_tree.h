@@ -0,0 +1,129 @@
+// Flattened, platform-independent layout tree.
+
+#ifndef WATERUI_LAYOUT_TREE_H
+#define WATERUI_LAYOUT_TREE_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Index of no node; the parent of the root.
+ */
+#define WUI_LAYOUT_TREE_NONE UINT32_MAX
+
+/**
+ * A layout tree stored as parallel arrays indexed by node.
+ *
+ * Each node is either a container, driven by a borrowed `WuiLayout`, or a leaf measured
+ * by a `WuiSubView` it owns. Parent indices, stretch axes, priorities, memoized sizes and
+ * frames live in contiguous arrays, and the children of a node occupy a contiguous index
+ * range that is handed to its layout directly. Children always come after their parent,
+ * so `waterui_layout_tree_compute` resolves every frame in one forward sweep without
+ * touching any platform view.
+ *
+ * The shape of the tree is append-only: nodes are added with
+ * `waterui_layout_tree_add_root` and `waterui_layout_tree_add_children`, and the tree is
+ * cleared and rebuilt when it changes. Layouts, leaves and traits can be replaced in place.
+ *
+ * This is a standalone API. The UIKit and AppKit containers do not build a tree; they
+ * negotiate through their `WuiSubViews` sets and the `WuiLayoutNode` hierarchy. The tree
+ * is for hosts that lay out a whole hierarchy without platform views, such as headless
+ * rendering, tests and the benchmarks under Tools/.
+ */
+typedef struct WuiLayoutTree WuiLayoutTree;
+
+/**
+ * Creates an empty tree with room for `capacity` nodes.
+ */
+struct WuiLayoutTree *waterui_layout_tree_new(uint32_t capacity);
+
+/**
+ * Drops the tree and the leaf subviews it owns. Layouts are borrowed and left alone.
+ */
+void waterui_layout_tree_drop(struct WuiLayoutTree *tree);
+
+/**
+ * Removes every node, dropping the leaf subviews, and keeps the storage.
+ */
+void waterui_layout_tree_clear(struct WuiLayoutTree *tree);
+
+/**
+ * Returns the number of nodes.
+ */
+uint32_t waterui_layout_tree_len(const struct WuiLayoutTree *tree);
+
+/**
+ * Adds the root node to an empty tree. Returns its index (0), or `WUI_LAYOUT_TREE_NONE`
+ * if the tree is not empty or allocation failed.
+ */
+uint32_t waterui_layout_tree_add_root(struct WuiLayoutTree *tree);
+
+/**
+ * Appends `count` children to `parent`, which must not have children yet.
+ *
+ * Returns the index of the first child; the others follow contiguously. New nodes are
+ * leaves that measure as zero until configured. Returns `WUI_LAYOUT_TREE_NONE` on
+ * failure.
+ */
+uint32_t waterui_layout_tree_add_children(struct WuiLayoutTree *tree, uint32_t parent, uint32_t count);
+
+/**
+ * Makes `node` a container driven by `layout`, which must outlive its use by the tree.
+ */
+void waterui_layout_tree_set_layout(struct WuiLayoutTree *tree, uint32_t node, struct WuiLayout *layout);
+
+/**
+ * Makes `node` a leaf measured by `leaf`, taking ownership of it. The node's stretch axis
+ * and priority are taken from `leaf`.
+ */
+void waterui_layout_tree_set_leaf(struct WuiLayoutTree *tree, uint32_t node, struct WuiSubView leaf);
+
+/**
+ * Sets the stretch axis and priority the node reports to its parent's layout.
+ */
+void waterui_layout_tree_set_traits(struct WuiLayoutTree *tree,
+                                    uint32_t node,
+                                    enum WuiStretchAxis stretch_axis,
+                                    int32_t priority);
+
+/**
+ * Forgets the memoized sizes of `node` and its ancestors and schedules them to be placed
+ * again. Call this when a leaf's content changes.
+ */
+void waterui_layout_tree_mark_dirty(struct WuiLayoutTree *tree, uint32_t node);
+
+/**
+ * Returns the parent of `node`, or `WUI_LAYOUT_TREE_NONE` for the root.
+ */
+uint32_t waterui_layout_tree_parent(const struct WuiLayoutTree *tree, uint32_t node);
+
+/**
+ * Measures `node` for `proposal`, answering from the memo where possible.
+ */
+struct WuiSize waterui_layout_tree_size_that_fits(struct WuiLayoutTree *tree,
+                                                  uint32_t node,
+                                                  struct WuiProposalSize proposal);
+
+/**
+ * Lays out the whole tree with the root occupying `root_frame`.
+ *
+ * Containers are visited in index order, each sized for and placed within its own frame,
+ * which writes the frames of its children. Subtrees that are clean and whose frame size
+ * did not change are skipped.
+ */
+void waterui_layout_tree_compute(struct WuiLayoutTree *tree, struct WuiRect root_frame);
+
+/**
+ * Returns the frames of all nodes, indexed by node. Each frame is in its parent's
+ * coordinate space. The pointer is valid until the tree is modified.
+ */
+const struct WuiRect *waterui_layout_tree_frames(const struct WuiLayoutTree *tree);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_LAYOUT_TREE_H */
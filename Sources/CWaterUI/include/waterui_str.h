@@ -0,0 +1,74 @@
+// Native-side string helpers.
+
+#ifndef WATERUI_STR_H
+#define WATERUI_STR_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Returns whether `len` bytes at `bytes` are well-formed UTF-8.
+ *
+ * Overlong forms, surrogates and code points past U+10FFFF are rejected. Runs of ASCII are
+ * skipped a vector at a time, so validating mostly-ASCII text costs little more than
+ * reading it. Bytes that pass can be handed to a decoder that trusts its input.
+ */
+bool waterui_utf8_valid(const uint8_t *bytes, uintptr_t len);
+
+/**
+ * Returns whether `len` bytes at `bytes` are all ASCII, which also makes them valid UTF-8.
+ *
+ * Uses the same vector scan as `waterui_utf8_valid` and stops at the first byte of 0x80
+ * or above. ASCII bytes decode to one UTF-16 unit each, so a decoder can keep them as
+ * they are instead of transcoding.
+ */
+bool waterui_utf8_is_ascii(const uint8_t *bytes, uintptr_t len);
+
+/**
+ * Longest string, in bytes, that `waterui_str_new` stores in a small-string cell.
+ */
+#define WUI_SMALL_STR_CAPACITY 24
+
+/**
+ * Creates an owned string holding a copy of `len` bytes at `bytes`.
+ *
+ * Strings of up to `WUI_SMALL_STR_CAPACITY` bytes are stored in fixed-size cells that are
+ * recycled through a small per-thread free list when the string is dropped, so steady
+ * short-string traffic on a thread does not reach the allocator and takes no lock. Cells
+ * beyond the list's bound, and a thread's list when it exits, are freed. The empty
+ * string allocates nothing. Longer strings get a single block. Thread-safe. Aborts if
+ * memory is exhausted.
+ */
+struct WuiStr waterui_str_new(const uint8_t *bytes, uintptr_t len);
+
+/**
+ * Returns a shared handle to `len` bytes at `bytes` from the process-wide intern table.
+ *
+ * Equal strings share one entry, which is created on first use and freed when the last
+ * handle is dropped through its vtable. Handles can be passed anywhere a `WuiStr` is
+ * expected. Interning an existing handle's bytes returns another reference to the same
+ * entry. Thread-safe.
+ */
+struct WuiStr waterui_str_intern(const uint8_t *bytes, uintptr_t len);
+
+/**
+ * Returns the intern ID of `str`, or 0 if it is not an interned handle.
+ *
+ * IDs are never reused, so two handles with the same ID hold the same bytes, and an ID
+ * can key a cache of values derived from the string.
+ */
+uint64_t waterui_str_intern_id(const struct WuiStr *str);
+
+/**
+ * Returns the number of live entries in the intern table.
+ */
+uintptr_t waterui_str_intern_count(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_STR_H */
@@ -0,0 +1,323 @@
+// Native-side extensions to the SubView layout protocol.
+
+#ifndef WATERUI_SUBVIEW_H
+#define WATERUI_SUBVIEW_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Per-child measure callback, as stored in `WuiSubViewVTable.measure`.
+ */
+typedef struct WuiSize (*WuiSubViewMeasureFn)(void *context, struct WuiProposalSize proposal);
+
+/**
+ * Batched measure callback.
+ *
+ * Measures `n` children in one call: `out_sizes[i]` receives the size of the child
+ * behind `contexts[i]` for `proposals[i]`.
+ */
+typedef void (*WuiSubViewMeasureManyFn)(void *const *contexts,
+                                        const struct WuiProposalSize *proposals,
+                                        struct WuiSize *out_sizes,
+                                        uintptr_t n);
+
+/**
+ * Optional batch entry for the SubView protocol.
+ *
+ * A backend that measures many children with the same callback can supply a
+ * `measure_many` that crosses the native boundary once per batch instead of once per
+ * child. Only children whose `vtable.measure` equals `measure` are routed through
+ * `measure_many`; every other child is measured individually.
+ */
+typedef struct WuiSubViewBatchVTable {
+  /**
+   * The per-child measure function this batch entry stands in for.
+   */
+  WuiSubViewMeasureFn measure;
+  /**
+   * Measures a run of children sharing `measure`.
+   */
+  WuiSubViewMeasureManyFn measure_many;
+} WuiSubViewBatchVTable;
+
+/**
+ * Measures `len` children, `children[i]` with `proposals[i]`, into `out_sizes`.
+ *
+ * Children served by `batch` are gathered and dispatched through `measure_many`;
+ * the rest fall back to their own `vtable.measure`. `batch` may be NULL, in which case
+ * every child is measured individually. No allocation is performed.
+ */
+void waterui_subviews_measure_many(const struct WuiSubView *children,
+                                   uintptr_t len,
+                                   const struct WuiProposalSize *proposals,
+                                   struct WuiSize *out_sizes,
+                                   const struct WuiSubViewBatchVTable *batch);
+
+/**
+ * Measures `len` children with the same `proposal` into `out_sizes`.
+ *
+ * This is the common probe of a stack layout and is equivalent to
+ * `waterui_subviews_measure_many` with every proposal set to `proposal`.
+ */
+void waterui_subviews_measure_uniform(const struct WuiSubView *children,
+                                      uintptr_t len,
+                                      struct WuiProposalSize proposal,
+                                      struct WuiSize *out_sizes,
+                                      const struct WuiSubViewBatchVTable *batch);
+
+/**
+ * A memo table of measurements for one child.
+ *
+ * The cache owns an inner `WuiSubView` and remembers the sizes it returned, keyed on the
+ * bit pattern of the proposal. All NaN encodings ("unspecified") share one key.
+ * Cached sizes stay valid until `waterui_measure_cache_invalidate` is called, which the
+ * owner must do whenever the child's content changes.
+ */
+typedef struct WuiMeasureCache WuiMeasureCache;
+
+/**
+ * Hit/miss counters for measure caches.
+ */
+typedef struct WuiMeasureCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t invalidations;
+} WuiMeasureCacheStats;
+
+/**
+ * Properties of a subview that the native side cannot infer from its vtable, supplied
+ * alongside the subview when it is handed to a cache or a set.
+ */
+typedef enum WuiSubViewFlags {
+  WuiSubViewFlags_None = 0,
+  /**
+   * The subview's `measure` is pure and may run on any thread, concurrently with the
+   * measures of other subviews. Set this only for children whose measurement touches no
+   * UI state, such as text shaping, icons or fixed-size content.
+   */
+  WuiSubViewFlags_ThreadSafe = 1 << 0,
+} WuiSubViewFlags;
+
+/**
+ * Creates a cache around `inner`, taking ownership of it.
+ *
+ * `inner_batch` is used to forward misses in batches and may be NULL. When non-NULL it
+ * must outlive the cache. `flags` is a set of `WuiSubViewFlags` describing `inner`.
+ */
+struct WuiMeasureCache *waterui_measure_cache_new(struct WuiSubView inner,
+                                                  const struct WuiSubViewBatchVTable *inner_batch,
+                                                  uint32_t flags);
+
+/**
+ * Returns the `WuiSubViewFlags` the cache was created with.
+ */
+uint32_t waterui_measure_cache_flags(const struct WuiMeasureCache *cache);
+
+/**
+ * Drops the cache together with the inner subview it owns.
+ */
+void waterui_measure_cache_drop(struct WuiMeasureCache *cache);
+
+/**
+ * Returns a subview that measures through the cache.
+ *
+ * The returned subview borrows `cache`: its `drop` is a no-op, and the cache must outlive
+ * every use of it. Stretch axis and priority are copied from the inner subview.
+ */
+struct WuiSubView waterui_measure_cache_subview(struct WuiMeasureCache *cache);
+
+/**
+ * Measures through the cache, calling the inner subview on a miss.
+ */
+struct WuiSize waterui_measure_cache_measure(struct WuiMeasureCache *cache,
+                                             struct WuiProposalSize proposal);
+
+/**
+ * Measures through the cache with `n` proposals at once, `proposals[i]` into
+ * `out_sizes[i]`. The misses are forwarded to the inner batch entry together, so a backend
+ * that supplies one is entered once per call rather than once per proposal.
+ */
+void waterui_measure_cache_measure_proposals(struct WuiMeasureCache *cache,
+                                             const struct WuiProposalSize *proposals,
+                                             struct WuiSize *out_sizes,
+                                             uintptr_t n);
+
+/**
+ * Forgets every cached measurement.
+ *
+ * The forgotten proposals are kept aside for `waterui_measure_cache_prefetch`.
+ */
+void waterui_measure_cache_invalidate(struct WuiMeasureCache *cache);
+
+/**
+ * Fills the cache for `proposal` and for every proposal asked before the last
+ * invalidation, measuring only those not already cached. Hit/miss counters are not
+ * touched.
+ *
+ * Unlike the other cache functions this may be called off the main thread, provided the
+ * inner subview is thread-safe (see `WuiSubViewFlags_ThreadSafe`) and no other thread
+ * uses the same cache meanwhile.
+ */
+void waterui_measure_cache_prefetch(struct WuiMeasureCache *cache, struct WuiProposalSize proposal);
+
+/**
+ * Re-measures every cached proposal and stores the fresh sizes.
+ *
+ * Returns true when any size differs from the cached one, when nothing was cached, or
+ * when entries were evicted since the last invalidation.
+ * Layouts are a function of their children's measurements, so a false result means the
+ * owning layout would reach the same result as before.
+ */
+bool waterui_measure_cache_revalidate(struct WuiMeasureCache *cache);
+
+/**
+ * Returns the counters of a single cache.
+ */
+struct WuiMeasureCacheStats waterui_measure_cache_stats(const struct WuiMeasureCache *cache);
+
+/**
+ * Returns the counters accumulated by every cache since the last reset.
+ */
+struct WuiMeasureCacheStats waterui_measure_cache_global_stats(void);
+
+/**
+ * Resets the global counters.
+ */
+void waterui_measure_cache_reset_global_stats(void);
+
+/**
+ * Batch entry for subviews returned by `waterui_measure_cache_subview`.
+ *
+ * Hits are answered from the caches; misses are forwarded to each cache's inner batch
+ * entry when one was supplied.
+ */
+const struct WuiSubViewBatchVTable *waterui_measure_cache_batch_vtable(void);
+
+/**
+ * A pool of worker threads that measures thread-safe children in parallel.
+ *
+ * A pool serves one prefetch at a time; sets that share a pool must be laid out from the
+ * same thread.
+ */
+typedef struct WuiMeasurePool WuiMeasurePool;
+
+/**
+ * Starts a pool with `workers` threads. The calling thread also takes part in every
+ * prefetch, so `workers` is usually the core count minus one.
+ */
+struct WuiMeasurePool *waterui_measure_pool_new(uint32_t workers);
+
+/**
+ * Stops and joins the workers. No set may still refer to the pool.
+ */
+void waterui_measure_pool_drop(struct WuiMeasurePool *pool);
+
+/**
+ * Returns the number of workers that were actually started.
+ */
+uint32_t waterui_measure_pool_workers(const struct WuiMeasurePool *pool);
+
+/**
+ * A persistent, C-owned set of child subviews.
+ *
+ * A container creates its set once and patches only the entries whose child changed,
+ * instead of rebuilding every proxy for every layout call. Each entry owns a
+ * `WuiMeasureCache`, so measurements survive between passes until invalidated.
+ */
+typedef struct WuiSubViews WuiSubViews;
+
+/**
+ * Creates an empty set with room for `capacity` entries.
+ */
+struct WuiSubViews *waterui_subviews_new(uintptr_t capacity);
+
+/**
+ * Drops the set and every entry it owns.
+ */
+void waterui_subviews_drop(struct WuiSubViews *subviews);
+
+/**
+ * Returns the number of entries.
+ */
+uintptr_t waterui_subviews_len(const struct WuiSubViews *subviews);
+
+/**
+ * Grows or truncates the set to `len` entries.
+ *
+ * Truncated entries are dropped. New entries measure as zero until they are filled in
+ * with `waterui_subviews_update`.
+ */
+void waterui_subviews_resize(struct WuiSubViews *subviews, uintptr_t len);
+
+/**
+ * Replaces the entry at `index`, taking ownership of `inner`.
+ *
+ * The previous entry and its cached measurements are dropped. `inner_batch` and `flags`
+ * have the same meaning as in `waterui_measure_cache_new`.
+ */
+void waterui_subviews_update(struct WuiSubViews *subviews,
+                             uintptr_t index,
+                             struct WuiSubView inner,
+                             const struct WuiSubViewBatchVTable *inner_batch,
+                             uint32_t flags);
+
+/**
+ * Returns the `WuiSubViewFlags` the entry at `index` was last updated with.
+ */
+uint32_t waterui_subviews_flags(const struct WuiSubViews *subviews, uintptr_t index);
+
+/**
+ * Opts the set in to parallel measuring through `pool`, which it borrows. Pass NULL to
+ * opt out.
+ */
+void waterui_subviews_set_measure_pool(struct WuiSubViews *subviews, struct WuiMeasurePool *pool);
+
+/**
+ * Prefetches `proposal` (and the proposals of the previous pass) into the caches of every
+ * thread-safe entry, spread over the set's measure pool. Entries without the flag are
+ * left for the layout to measure on the calling thread.
+ *
+ * The layout driver calls this before each size negotiation, so the layout's own probes
+ * mostly hit the caches. Does nothing when the set has no pool.
+ */
+void waterui_subviews_prefetch(struct WuiSubViews *subviews, struct WuiProposalSize proposal);
+
+/**
+ * Returns the entry indices ordered by descending priority, ties kept in index order:
+ * the order in which layouts measure children ("higher = measured first").
+ * `waterui_subviews_prefetch` hands it to the measure pool, so the children a layout
+ * probes first are the first to be warm.
+ *
+ * The permutation is cached in the set and only recomputed after the set is resized or an
+ * entry is replaced with a different priority. The returned array holds
+ * `waterui_subviews_len` indices and is valid until the set is next modified.
+ */
+const uint32_t *waterui_subviews_priority_order(struct WuiSubViews *subviews);
+
+/**
+ * Returns the measure cache of the entry at `index`, or NULL for an empty entry.
+ */
+struct WuiMeasureCache *waterui_subviews_cache(struct WuiSubViews *subviews, uintptr_t index);
+
+/**
+ * Forgets the cached measurements of every entry.
+ */
+void waterui_subviews_invalidate(struct WuiSubViews *subviews);
+
+/**
+ * Returns a borrowed array view over the entries, suitable for the layout functions.
+ *
+ * Dropping the array (or its elements) does not affect the set. The array is valid until
+ * the set is resized, updated or dropped.
+ */
+struct WuiArray_WuiSubView waterui_subviews_array(struct WuiSubViews *subviews);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_SUBVIEW_H */
@@ -0,0 +1,86 @@
+// Native-side helpers for watcher callbacks.
+
+#ifndef WATERUI_WATCHER_H
+#define WATERUI_WATCHER_H
+
+#include "waterui_ffi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum WuiWatcherFlags {
+  WuiWatcherFlags_None = 0,
+  /**
+   * The change should be animated; `animation` says how.
+   */
+  WuiWatcherFlags_Animated = 1 << 0,
+} WuiWatcherFlags;
+
+/**
+ * Watcher metadata as a plain value, with nothing left to drop.
+ */
+typedef struct WuiWatcherInfo {
+  struct WuiAnimation animation;
+  uint32_t flags;
+} WuiWatcherInfo;
+
+/**
+ * Reads `metadata` into a value and drops it, in a single call. A NULL `metadata` reads
+ * as no animation.
+ */
+struct WuiWatcherInfo waterui_watcher_metadata_take(struct WuiWatcherMetadata *metadata);
+
+/**
+ * A generation-checked reference to an object stored in the watcher slot table. Never 0,
+ * so it can stand in for a non-null context pointer.
+ *
+ * The low `WUI_SLOT_INDEX_BITS` bits hold the slot index and the bits above them the
+ * slot's generation, so a caller that keeps each handle next to its object can resolve
+ * one by masking and comparing, without calling `waterui_slot_index`.
+ */
+typedef uintptr_t WuiSlotHandle;
+
+/**
+ * Number of low handle bits holding the slot index. Targets with 32-bit pointers trade
+ * generation bits for a smaller table.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+#define WUI_SLOT_INDEX_BITS 32
+#else
+#define WUI_SLOT_INDEX_BITS 20
+#endif
+
+/**
+ * Takes a slot in the process-wide slot table and returns its handle.
+ *
+ * The table only hands out slots; callers keep the objects themselves in a side array
+ * indexed by `waterui_slot_index`, which stays dense because slots are recycled through a
+ * free list. Each reuse bumps the slot's generation, so handles to a removed object stop
+ * resolving instead of reaching whatever took its place. Like every function here, main
+ * thread only; nothing is locked. Returns 0 if the table is exhausted.
+ */
+WuiSlotHandle waterui_slot_insert(void);
+
+/**
+ * Returns the slot index behind `handle`, or -1 if it has been removed. A bounds and
+ * generation check, with no lock or atomic.
+ */
+intptr_t waterui_slot_index(WuiSlotHandle handle);
+
+/**
+ * Frees the slot behind `handle` and returns its index so the caller can release what it
+ * kept there, or -1 for a stale handle, so a second removal is harmless.
+ */
+intptr_t waterui_slot_remove(WuiSlotHandle handle);
+
+/**
+ * Returns the number of occupied slots.
+ */
+uintptr_t waterui_slot_count(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* WATERUI_WATCHER_H */
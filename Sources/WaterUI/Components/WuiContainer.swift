@@ -1,10 +1,11 @@
 // WuiContainer.swift
-// Dynamic container layout component - children accessed via Views trait (supports future lazy loading)
+// Dynamic container layout component - children accessed via Views trait (lazily inside scroll views)
 //
 // # Layout Behavior
 // Container delegates layout calculations to the Rust layout engine.
 // Size and placement are determined by the layout algorithm (VStack, HStack, etc.).
-// Children are accessed via WuiAnyViews for future lazy loading support.
+// Children are accessed via WuiAnyViews; inside a WuiScroll, large containers only realize
+// the children near the viewport and estimate the rest.
 //
 // // INTERNAL: Layout Contract for Backend Implementers
 // // - stretchAxis: Depends on children and layout algorithm
@@ -21,18 +22,27 @@ import OSLog
 #endif
 
 /// A native container that uses the Rust layout engine for child positioning.
-/// Container uses `WuiAnyViews` for dynamic child access, enabling future lazy loading.
+/// Container uses `WuiAnyViews` for dynamic child access. Large containers inside a
+/// `WuiScroll` realize only the children near the viewport.
 /// Similar to SwiftUI's ForEach - can access view IDs individually.
 @MainActor
-final class WuiContainer: PlatformView, WuiComponent {
+final class WuiContainer: PlatformView, WuiComponent, LayoutNodeOwner, ViewportObserver {
     static var rawId: CWaterUI.WuiTypeId { waterui_layout_container_id() }
 
     private(set) var stretchAxis: WuiStretchAxis
 
     private var wuiLayout: WuiLayout
     private var anyViews: WuiAnyViews  // Stored for lazy access & view ID lookup
-    private var childViews: [WuiAnyView] = []  // Currently loaded views
+    private var childViews: [WuiAnyView] = []  // Currently loaded views (eager mode)
+    private var lazySlots: [LazyChildSlot]?  // One per entry of `anyViews` (lazy mode)
+    private var realizedSlots = Set<Int>()  // Indices of lazy slots holding a view
+    private var slotAxis: SlotAxis?  // Axis the lazy slots ascend along, as of the last pass
+    private weak var viewportScroll: WuiScroll?
+    private var childrenLoaded = false
+    private var estimatedChildSize = EstimatedSize()
     private let bridge = NativeLayoutBridge()
+    private let subViewSet = SubViewSet()  // Persistent child handles, patched as children change
+    let layoutNode: OpaquePointer = waterui_layout_node_new()!  // Mirror in the native layout tree
     private let env: WuiEnvironment
 
     // MARK: - WuiComponent Init
@@ -54,9 +64,7 @@ final class WuiContainer: PlatformView, WuiComponent {
         self.anyViews = anyViews
         self.env = env
         super.init(frame: .zero)
-
-        // Currently load all children eagerly (can be changed to lazy later)
-        loadAllChildren()
+        // Children are loaded on first measurement, once the enclosing scroll view is known.
     }
 
     @available(*, unavailable)
@@ -64,8 +72,36 @@ final class WuiContainer: PlatformView, WuiComponent {
         fatalError("init(coder:) has not been implemented")
     }
 
+    @MainActor deinit {
+        waterui_layout_node_drop(layoutNode)
+    }
+
     // MARK: - Child Loading
 
+    /// Containers with more children than this realize them lazily inside a `WuiScroll`.
+    private static let lazyChildThreshold = 64
+    /// Children are realized within this fraction of the viewport beyond each edge...
+    private static let realizeOverscan: CGFloat = 0.5
+    /// ...and released once they are further than this away.
+    private static let releaseOverscan: CGFloat = 1.5
+
+    private var childCount: Int {
+        lazySlots?.count ?? childViews.count
+    }
+
+    private func loadChildrenIfNeeded() {
+        guard !childrenLoaded else { return }
+        childrenLoaded = true
+
+        if anyViews.count > Self.lazyChildThreshold, let scroll = enclosingWuiScroll {
+            lazySlots = (0..<anyViews.count).map { _ in LazyChildSlot() }
+            viewportScroll = scroll
+            scroll.addViewportObserver(self)
+        } else {
+            loadAllChildren()
+        }
+    }
+
     private func loadAllChildren() {
         childViews.reserveCapacity(anyViews.count)
         for i in 0..<anyViews.count {
@@ -85,17 +121,56 @@ final class WuiContainer: PlatformView, WuiComponent {
     // MARK: - WuiComponent
 
     func sizeThatFits(_ proposal: WuiProposalSize) -> CGSize {
-        let proxies = bridge.createSubViewProxies(children: childViews) { child, childProposal in
-            child.sizeThatFits(childProposal)
-        }
+        loadChildrenIfNeeded()
+        syncSubViews()
 
         return bridge.containerSize(
             layout: wuiLayout,
             parentProposal: proposal,
-            children: proxies
+            subviews: subViewSet
         )
     }
 
+    private func syncSubViews() {
+        guard let slots = lazySlots else {
+            bridge.syncSubViews(subViewSet, children: childViews) { child, childProposal in
+                child.sizeThatFits(childProposal)
+            }
+            return
+        }
+
+        // Unrealized children report default traits; realizing one changes its identity,
+        // which rebuilds its entry with the real ones.
+        subViewSet.sync(
+            count: slots.count,
+            identity: { slots[$0].view.map(ObjectIdentifier.init) ?? ObjectIdentifier(slots[$0]) },
+            traits: { index in
+                guard let view = slots[index].view else { return (.none, 0) }
+                return (view.stretchAxis, view.layoutPriority())
+            },
+            makeMeasure: { [unowned self] index in
+                let slot = slots[index]
+                return { [unowned self] proposal in self.measure(slot, proposal) }
+            }
+        )
+    }
+
+    /// Realized children measure themselves; the others answer from their last real
+    /// measurement or, failing that, from the average realized child.
+    private func measure(_ slot: LazyChildSlot, _ proposal: WuiProposalSize) -> CGSize {
+        if let view = slot.view {
+            let size = view.sizeThatFits(proposal)
+            estimatedChildSize.replace(slot.lastSize, with: size)
+            slot.lastSize = size
+            return size
+        }
+        var size = slot.lastSize ?? estimatedChildSize.average
+        if let width = proposal.width, width.isFinite {
+            size.width = min(size.width, CGFloat(width))
+        }
+        return size
+    }
+
     // MARK: - Layout
 
     #if canImport(UIKit)
@@ -129,58 +204,187 @@ final class WuiContainer: PlatformView, WuiComponent {
         override var isFlipped: Bool { true }
     #endif
 
+    /// Trait and environment changes can change every child's size; drop all cached
+    /// child measurements so the next pass sees the new sizes.
+    override func invalidateIntrinsicContentSize() {
+        super.invalidateIntrinsicContentSize()
+        subViewSet.invalidate()
+        waterui_layout_node_mark_dirty(layoutNode)
+    }
+
+    // An explicit layout request must run the next pass even when the bounds are unchanged.
+    #if canImport(UIKit)
+        override func setNeedsLayout() {
+            super.setNeedsLayout()
+            waterui_layout_node_mark_dirty(layoutNode)
+        }
+    #elseif canImport(AppKit)
+        override var needsLayout: Bool {
+            didSet {
+                if needsLayout {
+                    waterui_layout_node_mark_dirty(layoutNode)
+                }
+            }
+        }
+    #endif
+
+    // MARK: - LayoutNodeOwner
+
+    func childContentDidChange(_ child: PlatformView) -> Bool {
+        syncSubViews()
+        let index =
+            lazySlots?.firstIndex(where: { $0.view === child })
+            ?? childViews.firstIndex(where: { $0 === child })
+        guard let index else {
+            waterui_layout_node_mark_dirty(layoutNode)
+            return true
+        }
+        return subViewSet.childDidChange(at: index, node: layoutNode)
+    }
+
+    func invalidateForChildChange() {
+        super.invalidateIntrinsicContentSize()
+        waterui_layout_node_mark_dirty(layoutNode)
+    }
+
+    #if canImport(UIKit)
+        override func didMoveToSuperview() {
+            super.didMoveToSuperview()
+            waterui_layout_node_set_parent(layoutNode, ancestorLayoutNode)
+        }
+    #elseif canImport(AppKit)
+        override func viewDidMoveToSuperview() {
+            super.viewDidMoveToSuperview()
+            waterui_layout_node_set_parent(layoutNode, ancestorLayoutNode)
+        }
+    #endif
+
     private func performLayout() {
-        guard !childViews.isEmpty else { return }
+        loadChildrenIfNeeded()
+        guard childCount > 0 else { return }
+
+        // Clean containers whose bounds and pixel grid did not change keep their last
+        // placement.
+        let layoutBounds = WuiRect(bounds).toCStruct()
+        let scale = pixelScale
+        guard waterui_layout_node_needs_layout(layoutNode, layoutBounds, Float(scale)) else { return }
+        defer { waterui_layout_node_did_layout(layoutNode, layoutBounds, Float(scale)) }
+        // Transient native buffers of this pass come from the frame arena.
+        waterui_frame_arena_begin()
+        defer { waterui_frame_arena_end() }
 
         // CRITICAL: Create proposal from bounds so children measure with actual available width
         // This ensures VStack centering works correctly - children know the real container width
         let boundsProposal = WuiProposalSize(
             width: Float(bounds.width), height: Float(bounds.height))
 
-        let proxies = bridge.createSubViewProxies(children: childViews) { child, childProposal in
-            child.sizeThatFits(childProposal)
-        }
+        // Stale measurements were already refreshed: a changed child by `childContentDidChange`,
+        // everything else by `invalidateIntrinsicContentSize`.
+        syncSubViews()
 
         // Measure with bounds-based proposal first - this ensures children know available width
-        _ = bridge.containerSize(
-            layout: wuiLayout,
-            parentProposal: boundsProposal,
-            children: proxies
-        )
-
-        let rects = bridge.placements(
+        bridge.sizeAndPlace(
             layout: wuiLayout,
+            proposal: boundsProposal,
             bounds: bounds,
-            children: proxies
-        )
+            subviews: subViewSet,
+            scale: scale
+        ) { index, rect in
+            applyFrame(rect, toChildAt: index)
+        }
 
-        for (index, rect) in rects.enumerated() {
-            guard index < childViews.count else { break }
-            var frame = rect
-            guard frame.isValidForLayout else {
-                let warn =
-                    "[WuiLayout] Warning: WuiContainer received invalid rect for child \(index): \(frame)"
-                Logger.waterui.warning("\(warn)")
-                continue
-            }
+        if let slots = lazySlots {
+            slotAxis = SlotAxis(ascendingFramesOf: slots)
+        }
+        updateRealizedChildren()
+    }
 
-            #if canImport(AppKit)
-                // Convert to AppKit coordinate system if not flipped
-                if !isFlipped {
-                    frame.origin.y = bounds.height - frame.origin.y - frame.height
-                }
-            #endif
+    private func applyFrame(_ rect: CGRect, toChildAt index: Int) {
+        guard index < childCount else { return }
+        var frame = rect
+        guard frame.isValidForLayout else {
+            let warn =
+                "[WuiLayout] Warning: WuiContainer received invalid rect for child \(index): \(frame)"
+            Logger.waterui.warning("\(warn)")
+            return
+        }
 
+        #if canImport(AppKit)
+            // Convert to AppKit coordinate system if not flipped
+            if !isFlipped {
+                frame.origin.y = bounds.height - frame.origin.y - frame.height
+            }
+        #endif
+
+        if let slots = lazySlots {
+            slots[index].frame = frame
+            slots[index].view?.frame = frame
+        } else {
             childViews[index].frame = frame
         }
     }
 
+    // MARK: - Lazy Realization
+
+    func viewportDidChange() {
+        updateRealizedChildren()
+    }
+
+    /// Realizes the children whose last frame is near the viewport and releases the ones
+    /// that have moved well out of it. Only realized slots and, when the frames ascend along
+    /// one axis as a stack places them, the slots in the realize window are visited.
+    private func updateRealizedChildren() {
+        guard let slots = lazySlots, let scroll = viewportScroll else { return }
+        let viewport = scroll.viewport(in: self)
+        let realizeRect = viewport.insetBy(
+            dx: -viewport.width * Self.realizeOverscan, dy: -viewport.height * Self.realizeOverscan)
+        let keepRect = viewport.insetBy(
+            dx: -viewport.width * Self.releaseOverscan, dy: -viewport.height * Self.releaseOverscan)
+
+        for index in realizedSlots where !slots[index].frame.intersects(keepRect) {
+            slots[index].view?.removeFromSuperview()
+            slots[index].view = nil
+            realizedSlots.remove(index)
+        }
+
+        var realizedAny = false
+        let window = slotAxis?.window(of: slots, intersecting: realizeRect) ?? slots.indices
+        for index in window {
+            let slot = slots[index]
+            guard slot.view == nil, slot.frame.intersects(realizeRect) else { continue }
+            let child = anyViews.getView(at: index, env: env)
+            child.translatesAutoresizingMaskIntoConstraints = true
+            child.frame = slot.frame
+            addSubview(child)
+            slot.view = child
+            realizedSlots.insert(index)
+            realizedAny = true
+        }
+
+        // Estimates for the new children may have been off; lay out again with real sizes,
+        // letting the scroll view pick up any change in content size.
+        if realizedAny {
+            invalidateLayoutHierarchy()
+        }
+    }
+
     // MARK: - Child Management
 
     func setChildren(_ newChildren: [WuiAnyView]) {
         for child in childViews {
             child.removeFromSuperview()
         }
+        if let slots = lazySlots {
+            for slot in slots {
+                slot.view?.removeFromSuperview()
+            }
+            lazySlots = nil
+            realizedSlots = []
+            slotAxis = nil
+            viewportScroll?.removeViewportObserver(self)
+            viewportScroll = nil
+        }
+        childrenLoaded = true
 
         childViews = newChildren
         for child in newChildren {
@@ -195,3 +399,99 @@ final class WuiContainer: PlatformView, WuiComponent {
         #endif
     }
 }
+
+// MARK: - Lazy Child Slot
+
+/// A child position in a lazily realized container.
+@MainActor
+private final class LazyChildSlot {
+    /// The realized view, or nil while the child is away from the viewport.
+    var view: WuiAnyView?
+    /// The child's most recent real measurement, kept after its view is released.
+    var lastSize: CGSize?
+    /// Where the last layout pass placed the child.
+    var frame: CGRect = .zero
+}
+
+/// An axis along which both edges of the lazy slots' frames never decrease, so the slots
+/// meeting a rect form one contiguous run that two binary searches find.
+private enum SlotAxis {
+    case vertical
+    case horizontal
+
+    /// The axis the frames of `slots` ascend along, vertical first, or nil if neither.
+    @MainActor
+    init?(ascendingFramesOf slots: [LazyChildSlot]) {
+        func ascends(_ axis: SlotAxis) -> Bool {
+            zip(slots, slots.dropFirst()).allSatisfy { previous, next in
+                axis.min(previous.frame) <= axis.min(next.frame)
+                    && axis.max(previous.frame) <= axis.max(next.frame)
+            }
+        }
+        if ascends(.vertical) {
+            self = .vertical
+        } else if ascends(.horizontal) {
+            self = .horizontal
+        } else {
+            return nil
+        }
+    }
+
+    func min(_ rect: CGRect) -> CGFloat {
+        self == .vertical ? rect.minY : rect.minX
+    }
+
+    func max(_ rect: CGRect) -> CGFloat {
+        self == .vertical ? rect.maxY : rect.maxX
+    }
+
+    /// Indices of the slots whose frames overlap `rect` along this axis.
+    @MainActor
+    func window(of slots: [LazyChildSlot], intersecting rect: CGRect) -> Range<Int> {
+        let lower = firstIndex(in: slots) { max($0.frame) > min(rect) }
+        let upper = firstIndex(in: slots) { min($0.frame) >= max(rect) }
+        return lower..<Swift.max(lower, upper)
+    }
+
+    /// The first index for which `isPast` holds, given that it holds for every later one.
+    @MainActor
+    private func firstIndex(in slots: [LazyChildSlot], where isPast: (LazyChildSlot) -> Bool) -> Int {
+        var low = 0
+        var high = slots.count
+        while low < high {
+            let mid = (low + high) / 2
+            if isPast(slots[mid]) {
+                high = mid
+            } else {
+                low = mid + 1
+            }
+        }
+        return low
+    }
+}
+
+/// Running average of the sizes measured by realized children, used as the estimate for
+/// children that were never realized.
+private struct EstimatedSize {
+    private var total = CGSize.zero
+    private var count = 0
+
+    /// Default until the first child has been measured.
+    private static let fallback = CGSize(width: 0, height: 44)
+
+    var average: CGSize {
+        guard count > 0 else { return Self.fallback }
+        return CGSize(width: total.width / CGFloat(count), height: total.height / CGFloat(count))
+    }
+
+    mutating func replace(_ old: CGSize?, with new: CGSize) {
+        if let old {
+            total.width -= old.width
+            total.height -= old.height
+        } else {
+            count += 1
+        }
+        total.width += new.width
+        total.height += new.height
+    }
+}
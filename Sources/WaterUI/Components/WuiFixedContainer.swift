@@ -25,7 +25,7 @@ private let logger = Logger(subsystem: "dev.waterui", category: "layout")
 /// A native container that uses the Rust layout engine for child positioning.
 /// FixedContainer has a fixed array of children - no lazy loading support.
 @MainActor
-final class WuiFixedContainer: PlatformView, WuiComponent {
+final class WuiFixedContainer: PlatformView, WuiComponent, LayoutNodeOwner {
     static var rawId: CWaterUI.WuiTypeId { waterui_fixed_container_id() }
 
     private(set) var stretchAxis: WuiStretchAxis
@@ -33,6 +33,8 @@ final class WuiFixedContainer: PlatformView, WuiComponent {
     private var wuiLayout: WuiLayout
     private var childViews: [WuiAnyView]
     private let bridge = NativeLayoutBridge()
+    private let subViewSet = SubViewSet()  // Persistent child handles, patched as children change
+    let layoutNode: OpaquePointer = waterui_layout_node_new()!  // Mirror in the native layout tree
 
     // MARK: - WuiComponent Init
 
@@ -41,8 +43,8 @@ final class WuiFixedContainer: PlatformView, WuiComponent {
         let container: CWaterUI.WuiFixedContainer = waterui_force_as_fixed_container(anyview)
         let layout = WuiLayout(inner: container.layout!)
         let pointerArray = WuiArray<OpaquePointer>(container.contents)
-        let childViews = pointerArray.toArray().map {
-            WuiAnyView(anyview: $0, env: env)
+        let childViews = pointerArray.withUnsafeBufferPointer { buffer in
+            buffer.map { WuiAnyView(anyview: $0, env: env) }
         }
         self.init(stretchAxis: stretchAxis, layout: layout, children: childViews)
     }
@@ -66,20 +68,28 @@ final class WuiFixedContainer: PlatformView, WuiComponent {
         fatalError("init(coder:) has not been implemented")
     }
 
+    @MainActor deinit {
+        waterui_layout_node_drop(layoutNode)
+    }
+
     // MARK: - WuiComponent
 
     func sizeThatFits(_ proposal: WuiProposalSize) -> CGSize {
-        let proxies = bridge.createSubViewProxies(children: childViews) { child, childProposal in
-            child.sizeThatFits(childProposal)
-        }
+        syncSubViews()
 
         return bridge.containerSize(
             layout: wuiLayout,
             parentProposal: proposal,
-            children: proxies
+            subviews: subViewSet
         )
     }
 
+    private func syncSubViews() {
+        bridge.syncSubViews(subViewSet, children: childViews) { child, childProposal in
+            child.sizeThatFits(childProposal)
+        }
+    }
+
     // MARK: - Layout
 
     #if canImport(UIKit)
@@ -113,60 +123,121 @@ final class WuiFixedContainer: PlatformView, WuiComponent {
     override var isFlipped: Bool { true }
     #endif
 
+    /// Trait and environment changes can change every child's size; drop all cached
+    /// child measurements so the next pass sees the new sizes.
+    override func invalidateIntrinsicContentSize() {
+        super.invalidateIntrinsicContentSize()
+        subViewSet.invalidate()
+        waterui_layout_node_mark_dirty(layoutNode)
+    }
+
+    // An explicit layout request must run the next pass even when the bounds are unchanged.
+    #if canImport(UIKit)
+    override func setNeedsLayout() {
+        super.setNeedsLayout()
+        waterui_layout_node_mark_dirty(layoutNode)
+    }
+    #elseif canImport(AppKit)
+    override var needsLayout: Bool {
+        didSet {
+            if needsLayout {
+                waterui_layout_node_mark_dirty(layoutNode)
+            }
+        }
+    }
+    #endif
+
+    // MARK: - LayoutNodeOwner
+
+    func childContentDidChange(_ child: PlatformView) -> Bool {
+        syncSubViews()
+        guard let index = childViews.firstIndex(where: { $0 === child }) else {
+            waterui_layout_node_mark_dirty(layoutNode)
+            return true
+        }
+        return subViewSet.childDidChange(at: index, node: layoutNode)
+    }
+
+    func invalidateForChildChange() {
+        super.invalidateIntrinsicContentSize()
+        waterui_layout_node_mark_dirty(layoutNode)
+    }
+
+    #if canImport(UIKit)
+    override func didMoveToSuperview() {
+        super.didMoveToSuperview()
+        waterui_layout_node_set_parent(layoutNode, ancestorLayoutNode)
+    }
+    #elseif canImport(AppKit)
+    override func viewDidMoveToSuperview() {
+        super.viewDidMoveToSuperview()
+        waterui_layout_node_set_parent(layoutNode, ancestorLayoutNode)
+    }
+    #endif
+
     private func performLayout() {
         guard !childViews.isEmpty else { return }
 
+        // Clean containers whose bounds and pixel grid did not change keep their last
+        // placement.
+        let layoutBounds = WuiRect(bounds).toCStruct()
+        let scale = pixelScale
+        guard waterui_layout_node_needs_layout(layoutNode, layoutBounds, Float(scale)) else { return }
+        defer { waterui_layout_node_did_layout(layoutNode, layoutBounds, Float(scale)) }
+        // Transient native buffers of this pass come from the frame arena.
+        waterui_frame_arena_begin()
+        defer { waterui_frame_arena_end() }
+
         // CRITICAL: Create proposal from bounds so children measure with actual available width
         // This ensures VStack centering works correctly - children know the real container width
         let boundsProposal = WuiProposalSize(width: Float(bounds.width), height: Float(bounds.height))
 
-        let proxies = bridge.createSubViewProxies(children: childViews) { child, childProposal in
-            child.sizeThatFits(childProposal)
-        }
+        // Stale measurements were already refreshed: a changed child by `childContentDidChange`,
+        // everything else by `invalidateIntrinsicContentSize`.
+        syncSubViews()
 
-        // Measure with bounds-based proposal first - this ensures children know available width
-        _ = bridge.containerSize(
-            layout: wuiLayout,
-            parentProposal: boundsProposal,
-            children: proxies
-        )
+        // Debug: log layout info if there are more than 2 children (likely a table or complex layout)
+        let logsPlacement = childViews.count > 2
 
-        let rects = bridge.placements(
+        // Measure with bounds-based proposal first - this ensures children know available width
+        let rectCount = bridge.sizeAndPlace(
             layout: wuiLayout,
+            proposal: boundsProposal,
             bounds: bounds,
-            children: proxies
-        )
+            subviews: subViewSet,
+            scale: scale
+        ) { index, rect in
+            if logsPlacement {
+                let rectDesc = rect.debugDescription
+                logger.info("  child[\(index)] rect=\(rectDesc)")
+            }
+            applyFrame(rect, toChildAt: index)
+        }.count
 
-        // Debug: log layout info if there are more than 2 children (likely a table or complex layout)
-        if childViews.count > 2 {
+        if logsPlacement {
             let boundsDesc = bounds.debugDescription
             let childCount = childViews.count
-            let rectCount = rects.count
             logger.info("[WuiFixedContainer] bounds=\(boundsDesc), children=\(childCount), rects=\(rectCount)")
-            for (index, rect) in rects.enumerated() {
-                let rectDesc = rect.debugDescription
-                logger.info("  child[\(index)] rect=\(rectDesc)")
-            }
         }
+    }
 
-        for (index, rect) in rects.enumerated() {
-            guard index < childViews.count else { break }
-            var frame = rect
-            guard frame.isValidForLayout else {
-                let frameDesc = frame.debugDescription
-                logger.warning("WuiFixedContainer received invalid rect for child \(index): \(frameDesc)")
-                continue
-            }
-
-            #if canImport(AppKit)
-            // Convert to AppKit coordinate system if not flipped
-            if !isFlipped {
-                frame.origin.y = bounds.height - frame.origin.y - frame.height
-            }
-            #endif
+    private func applyFrame(_ rect: CGRect, toChildAt index: Int) {
+        guard index < childViews.count else { return }
+        var frame = rect
+        guard frame.isValidForLayout else {
+            let frameDesc = frame.debugDescription
+            logger.warning("WuiFixedContainer received invalid rect for child \(index): \(frameDesc)")
+            return
+        }
 
-            childViews[index].frame = frame
+        #if canImport(AppKit)
+        // Convert to AppKit coordinate system if not flipped
+        if !isFlipped {
+            frame.origin.y = bounds.height - frame.origin.y - frame.height
         }
+        #endif
+
+        childViews[index].frame = frame
     }
 
     // MARK: - Child Management
@@ -35,7 +35,7 @@ final class WuiPlain: WuiTextBase, WuiComponent {
         super.init(initialText: text)
         #else
         super.init(frame: .zero)
-        label.text = text
+        setText(text)
         #endif
 
         setupFontFromEnv(env)
@@ -28,6 +28,8 @@ final class WuiScroll: UIScrollView, WuiComponent, UIScrollViewDelegate {
 
     private var contentView: WuiAnyView
     private let axis: WuiAxis
+    /// Lazily realized descendants, told when the visible region moves.
+    fileprivate let viewportObservers = NSHashTable<AnyObject>.weakObjects()
 
     // MARK: - WuiComponent Init
 
@@ -134,6 +136,12 @@ final class WuiScroll: UIScrollView, WuiComponent, UIScrollViewDelegate {
     override var intrinsicContentSize: CGSize {
         CGSize(width: UIView.noIntrinsicMetric, height: UIView.noIntrinsicMetric)
     }
+
+    // MARK: - UIScrollViewDelegate
+
+    func scrollViewDidScroll(_ scrollView: UIScrollView) {
+        notifyViewportObservers()
+    }
 }
 #endif
 
@@ -146,6 +154,8 @@ final class WuiScroll: NSScrollView, WuiComponent {
 
     private var contentHostView: WuiAnyView
     private let axis: WuiAxis
+    /// Lazily realized descendants, told when the visible region moves.
+    fileprivate let viewportObservers = NSHashTable<AnyObject>.weakObjects()
 
     // MARK: - WuiComponent Init
 
@@ -247,6 +257,11 @@ final class WuiScroll: NSScrollView, WuiComponent {
     override var intrinsicContentSize: NSSize {
         NSSize(width: NSView.noIntrinsicMetric, height: NSView.noIntrinsicMetric)
     }
+
+    override func reflectScrolledClipView(_ cView: NSClipView) {
+        super.reflectScrolledClipView(cView)
+        notifyViewportObservers()
+    }
 }
 
 // MARK: - Flipped Document View
@@ -255,3 +270,51 @@ private class FlippedView: NSView {
     override var isFlipped: Bool { true }
 }
 #endif
+
+// MARK: - Viewport
+
+/// A descendant of a `WuiScroll` whose content depends on what is visible, such as a
+/// container that only realizes the children near the viewport.
+@MainActor
+protocol ViewportObserver: AnyObject {
+    func viewportDidChange()
+}
+
+extension WuiScroll {
+    func addViewportObserver(_ observer: ViewportObserver) {
+        viewportObservers.add(observer)
+    }
+
+    func removeViewportObserver(_ observer: ViewportObserver) {
+        viewportObservers.remove(observer)
+    }
+
+    /// The visible part of the scrolled content, in `view`'s coordinate space.
+    func viewport(in view: PlatformView) -> CGRect {
+        #if canImport(UIKit)
+        return convert(bounds, to: view)
+        #elseif canImport(AppKit)
+        return contentView.convert(contentView.bounds, to: view)
+        #endif
+    }
+
+    fileprivate func notifyViewportObservers() {
+        for case let observer as ViewportObserver in viewportObservers.allObjects {
+            observer.viewportDidChange()
+        }
+    }
+}
+
+extension PlatformView {
+    /// The nearest `WuiScroll` above this view, if any.
+    var enclosingWuiScroll: WuiScroll? {
+        var parent = superview
+        while let p = parent {
+            if let scroll = p as? WuiScroll {
+                return scroll
+            }
+            parent = p.superview
+        }
+        return nil
+    }
+}
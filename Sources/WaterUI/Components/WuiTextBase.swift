@@ -23,6 +23,9 @@ class WuiTextBase: PlatformView {
     let textField: NSTextField
     #endif
 
+    /// What the text measures with, republished whenever content or styling changes.
+    private let measureSnapshot = TextMeasureSnapshot()
+
     #if canImport(AppKit)
     init(initialText: String = "") {
         self.textField = NSTextField(labelWithString: initialText)
@@ -75,49 +78,14 @@ class WuiTextBase: PlatformView {
             textField.bottomAnchor.constraint(equalTo: bottomAnchor)
         ])
         #endif
+        publishMeasureSpec()
     }
 
     // MARK: - Size Calculation
 
+    /// Measures the published text; the same measurement answers concurrent requests.
     func sizeThatFits(_ proposal: WuiProposalSize) -> CGSize {
-        #if canImport(UIKit)
-        let maxWidth = proposal.width.map(CGFloat.init) ?? CGFloat.greatestFiniteMagnitude
-        let maxHeight = proposal.height.map(CGFloat.init) ?? CGFloat.greatestFiniteMagnitude
-        let measured = label.sizeThatFits(CGSize(width: maxWidth, height: maxHeight))
-        return CGSize(
-            width: ceil(min(measured.width, maxWidth)),
-            height: ceil(min(measured.height, maxHeight))
-        )
-        #elseif canImport(AppKit)
-        guard let cell = textField.cell else {
-            return .zero
-        }
-
-        let attributedText = textField.attributedStringValue
-        guard attributedText.length > 0 else {
-            return .zero
-        }
-
-        let maxHeight = proposal.height.map(CGFloat.init) ?? CGFloat.greatestFiniteMagnitude
-
-        let intrinsic = cell.cellSize(forBounds: CGRect(
-            origin: .zero,
-            size: CGSize(width: CGFloat.greatestFiniteMagnitude, height: maxHeight)
-        ))
-
-        if let proposedWidth = proposal.width {
-            let maxWidth = CGFloat(proposedWidth)
-            if intrinsic.width > maxWidth {
-                let constrained = cell.cellSize(forBounds: CGRect(
-                    origin: .zero,
-                    size: CGSize(width: maxWidth, height: maxHeight)
-                ))
-                return CGSize(width: ceil(maxWidth), height: ceil(min(constrained.height, maxHeight)))
-            }
-        }
-
-        return CGSize(width: ceil(intrinsic.width), height: ceil(min(intrinsic.height, maxHeight)))
-        #endif
+        measureSnapshot.spec.size(for: proposal)
     }
 
     #if canImport(AppKit)
@@ -126,6 +94,15 @@ class WuiTextBase: PlatformView {
 
     // MARK: - Text Updates
 
+    func setText(_ text: String) {
+        #if canImport(UIKit)
+        label.text = text
+        #elseif canImport(AppKit)
+        textField.stringValue = text
+        #endif
+        invalidateLayout()
+    }
+
     func setAttributedText(_ attributed: NSAttributedString) {
         #if canImport(UIKit)
         label.attributedText = attributed
@@ -150,6 +127,141 @@ class WuiTextBase: PlatformView {
         #elseif canImport(AppKit)
         textField.invalidateIntrinsicContentSize()
         #endif
+        publishMeasureSpec()
         invalidateLayoutHierarchy()
     }
+
+    /// Copies everything the text's size depends on out of the label or field.
+    private func publishMeasureSpec() {
+        #if canImport(UIKit)
+        // UILabel lays its text out edge to edge, so there are no insets to account for.
+        measureSnapshot.spec = TextMeasureSpec(
+            text: label.attributedText ?? NSAttributedString(),
+            font: label.font,
+            numberOfLines: label.numberOfLines,
+            lineBreakMode: label.lineBreakMode,
+            padding: .zero
+        )
+        #elseif canImport(AppKit)
+        // The cell insets its title; the difference between a probe rect and the title rect
+        // it reports for it is the padding `cellSize(forBounds:)` would add.
+        var padding = CGSize.zero
+        if let cell = textField.cell {
+            let probe = CGRect(x: 0, y: 0, width: 1000, height: 1000)
+            let title = cell.titleRect(forBounds: probe)
+            padding = CGSize(width: probe.width - title.width, height: probe.height - title.height)
+        }
+        measureSnapshot.spec = TextMeasureSpec(
+            text: textField.attributedStringValue,
+            font: textField.font,
+            numberOfLines: textField.maximumNumberOfLines,
+            lineBreakMode: textField.lineBreakMode,
+            padding: padding
+        )
+        #endif
+    }
+}
+
+// MARK: - Concurrent Measurement
+
+extension WuiTextBase: ConcurrentlyMeasurable {
+    /// Measures the published spec, exactly as `sizeThatFits` does on the main actor.
+    var concurrentMeasure: ConcurrentMeasure? {
+        let snapshot = measureSnapshot
+        return { proposal in snapshot.spec.size(for: proposal) }
+    }
+}
+
+/// The measure spec published by a `WuiTextBase`.
+///
+/// The main actor replaces `spec` only between layout passes, and a measure pool's workers
+/// read it only during a pass while the main thread waits for them; the pool's lock
+/// orders the two, so no further synchronization is needed.
+private final class TextMeasureSnapshot: @unchecked Sendable {
+    var spec = TextMeasureSpec()
+}
+
+/// Text and line settings of a label, measured with TextKit so that any thread can use it.
+///
+/// Each measurement builds its own layout manager, which TextKit allows off the main
+/// thread as long as the instance stays on one thread.
+private struct TextMeasureSpec: @unchecked Sendable {
+    /// Immutable copy with the label's font filled in wherever the text sets none.
+    let text: NSAttributedString
+    let numberOfLines: Int
+    let lineBreakMode: NSLineBreakMode
+    /// Space the label or cell adds around the laid-out text.
+    let padding: CGSize
+
+    init() {
+        self.text = NSAttributedString()
+        self.numberOfLines = 0
+        self.lineBreakMode = .byWordWrapping
+        self.padding = .zero
+    }
+
+    init(
+        text: NSAttributedString,
+        font: PlatformFont?,
+        numberOfLines: Int,
+        lineBreakMode: NSLineBreakMode,
+        padding: CGSize
+    ) {
+        let copy = NSMutableAttributedString(attributedString: text)
+        if let font {
+            let range = NSRange(location: 0, length: copy.length)
+            copy.enumerateAttribute(.font, in: range) { value, run, _ in
+                if value == nil {
+                    copy.addAttribute(.font, value: font, range: run)
+                }
+            }
+        }
+        self.text = copy
+        self.numberOfLines = numberOfLines
+        self.lineBreakMode = lineBreakMode
+        self.padding = padding
+    }
+
+    func size(for proposal: WuiProposalSize) -> CGSize {
+        guard text.length > 0 else {
+            return .zero
+        }
+        let maxHeight = proposal.height.map(CGFloat.init) ?? CGFloat.greatestFiniteMagnitude
+        let unconstrained = usedSize(width: CGFloat.greatestFiniteMagnitude)
+
+        guard let proposedWidth = proposal.width.map(CGFloat.init),
+            unconstrained.width + padding.width > proposedWidth
+        else {
+            return CGSize(
+                width: ceil(unconstrained.width + padding.width),
+                height: ceil(min(unconstrained.height + padding.height, maxHeight))
+            )
+        }
+
+        let wrapped = usedSize(width: max(proposedWidth - padding.width, 0))
+        #if canImport(AppKit)
+        // Wrapped text fills the proposed width, as the cell reports it.
+        let width = proposedWidth
+        #else
+        let width = min(wrapped.width + padding.width, proposedWidth)
+        #endif
+        return CGSize(
+            width: ceil(width),
+            height: ceil(min(wrapped.height + padding.height, maxHeight))
+        )
+    }
+
+    private func usedSize(width: CGFloat) -> CGSize {
+        let storage = NSTextStorage(attributedString: text)
+        let manager = NSLayoutManager()
+        let container = NSTextContainer(
+            size: CGSize(width: width, height: CGFloat.greatestFiniteMagnitude))
+        container.lineFragmentPadding = 0
+        container.maximumNumberOfLines = numberOfLines
+        container.lineBreakMode = lineBreakMode
+        manager.addTextContainer(container)
+        storage.addLayoutManager(manager)
+        manager.ensureLayout(for: container)
+        return manager.usedRect(for: container).size
+    }
 }
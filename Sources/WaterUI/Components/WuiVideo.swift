@@ -160,7 +160,7 @@ final class WuiVideo: PlatformView, WuiComponent {
         // Emit ended event
         let event = CWaterUI.WuiVideoEvent(
             event_type: CWaterUI.WuiVideoEventType_Ended,
-            error_message: WuiStr(string: "").intoInner()
+            error_message: WuiStr.raw("")
         )
         onEvent.call(onEvent.data, event)
 
@@ -188,7 +188,7 @@ final class WuiVideo: PlatformView, WuiComponent {
             // Emit error event
             let event = CWaterUI.WuiVideoEvent(
                 event_type: CWaterUI.WuiVideoEventType_Error,
-                error_message: WuiStr(string: "Invalid video URL").intoInner()
+                error_message: WuiStr.raw("Invalid video URL")
             )
             onEvent.call(onEvent.data, event)
             return
@@ -217,14 +217,14 @@ final class WuiVideo: PlatformView, WuiComponent {
                     // Emit error event
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_Error,
-                        error_message: WuiStr(string: errorMessage).intoInner()
+                        error_message: WuiStr.raw(errorMessage)
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 case .readyToPlay:
                     // Emit ready event
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_ReadyToPlay,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 case .unknown:
@@ -243,7 +243,7 @@ final class WuiVideo: PlatformView, WuiComponent {
                     self.isBuffering = true
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_Buffering,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 }
@@ -258,7 +258,7 @@ final class WuiVideo: PlatformView, WuiComponent {
                     self.isBuffering = false
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_BufferingEnded,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 }
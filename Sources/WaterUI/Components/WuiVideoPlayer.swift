@@ -273,7 +273,7 @@ final class WuiVideoPlayer: PlatformView, WuiComponent {
         // Emit ended event
         let event = CWaterUI.WuiVideoEvent(
             event_type: CWaterUI.WuiVideoEventType_Ended,
-            error_message: WuiStr(string: "").intoInner()
+            error_message: WuiStr.raw("")
         )
         onEvent.call(onEvent.data, event)
     }
@@ -295,7 +295,7 @@ final class WuiVideoPlayer: PlatformView, WuiComponent {
             // Emit error event
             let event = CWaterUI.WuiVideoEvent(
                 event_type: CWaterUI.WuiVideoEventType_Error,
-                error_message: WuiStr(string: "Invalid video URL").intoInner()
+                error_message: WuiStr.raw("Invalid video URL")
             )
             onEvent.call(onEvent.data, event)
             return
@@ -324,14 +324,14 @@ final class WuiVideoPlayer: PlatformView, WuiComponent {
                     // Emit error event
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_Error,
-                        error_message: WuiStr(string: errorMessage).intoInner()
+                        error_message: WuiStr.raw(errorMessage)
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 case .readyToPlay:
                     // Emit ready event
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_ReadyToPlay,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 case .unknown:
@@ -350,7 +350,7 @@ final class WuiVideoPlayer: PlatformView, WuiComponent {
                     self.isBuffering = true
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_Buffering,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 }
@@ -365,7 +365,7 @@ final class WuiVideoPlayer: PlatformView, WuiComponent {
                     self.isBuffering = false
                     let event = CWaterUI.WuiVideoEvent(
                         event_type: CWaterUI.WuiVideoEventType_BufferingEnded,
-                        error_message: WuiStr(string: "").intoInner()
+                        error_message: WuiStr.raw("")
                     )
                     self.onEvent.call(self.onEvent.data, event)
                 }
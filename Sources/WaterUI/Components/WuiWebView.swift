@@ -116,9 +116,9 @@ final class WebViewWrapper: NSObject {
     private func emitStateChanged() {
         let event = CWaterUI.WuiWebViewEvent(
             event_type: WuiWebViewEventType_StateChanged,
-            url: WuiStr(string: "").intoInner(),
-            url2: WuiStr(string: "").intoInner(),
-            message: WuiStr(string: "").intoInner(),
+            url: WuiStr.raw(""),
+            url2: WuiStr.raw(""),
+            message: WuiStr.raw(""),
             progress: 0,
             can_go_back: webView.canGoBack,
             can_go_forward: webView.canGoForward
@@ -134,9 +134,9 @@ final class WebViewWrapper: NSObject {
         lastNavigationUrl = urlString
         let event = CWaterUI.WuiWebViewEvent(
             event_type: WuiWebViewEventType_WillNavigate,
-            url: WuiStr(string: urlString).intoInner(),
-            url2: WuiStr(string: "").intoInner(),
-            message: WuiStr(string: "").intoInner(),
+            url: WuiStr.raw(urlString),
+            url2: WuiStr.raw(""),
+            message: WuiStr.raw(""),
             progress: 0,
             can_go_back: false,
             can_go_forward: false
@@ -153,7 +153,7 @@ final class WebViewWrapper: NSObject {
 
             if let error = error {
                 let errorMsg = error.localizedDescription
-                let errorStr = WuiStr(string: errorMsg).intoInner()
+                let errorStr = WuiStr.raw(errorMsg)
                 callbackFn?(callbackData, false, errorStr)
             } else {
                 let resultStr: String
@@ -170,7 +170,7 @@ final class WebViewWrapper: NSObject {
                 } else {
                     resultStr = "null"
                 }
-                let wuiStr = WuiStr(string: resultStr).intoInner()
+                let wuiStr = WuiStr.raw(resultStr)
                 callbackFn?(callbackData, true, wuiStr)
             }
         }
@@ -318,9 +318,9 @@ extension WebViewWrapper: WKNavigationDelegate {
 
                 let event = CWaterUI.WuiWebViewEvent(
                     event_type: WuiWebViewEventType_Redirect,
-                    url: WuiStr(string: fromUrl).intoInner(),
-                    url2: WuiStr(string: toUrl).intoInner(),
-                    message: WuiStr(string: "").intoInner(),
+                    url: WuiStr.raw(fromUrl),
+                    url2: WuiStr.raw(toUrl),
+                    message: WuiStr.raw(""),
                     progress: 0,
                     can_go_back: false,
                     can_go_forward: false
@@ -349,9 +349,9 @@ extension WebViewWrapper: WKNavigationDelegate {
         Task { @MainActor in
             let event = CWaterUI.WuiWebViewEvent(
                 event_type: WuiWebViewEventType_Loaded,
-                url: WuiStr(string: "").intoInner(),
-                url2: WuiStr(string: "").intoInner(),
-                message: WuiStr(string: "").intoInner(),
+                url: WuiStr.raw(""),
+                url2: WuiStr.raw(""),
+                message: WuiStr.raw(""),
                 progress: 1.0,
                 can_go_back: false,
                 can_go_forward: false
@@ -367,9 +367,9 @@ extension WebViewWrapper: WKNavigationDelegate {
         Task { @MainActor in
             let event = CWaterUI.WuiWebViewEvent(
                 event_type: WuiWebViewEventType_Error,
-                url: WuiStr(string: "").intoInner(),
-                url2: WuiStr(string: "").intoInner(),
-                message: WuiStr(string: error.localizedDescription).intoInner(),
+                url: WuiStr.raw(""),
+                url2: WuiStr.raw(""),
+                message: WuiStr.raw(error.localizedDescription),
                 progress: 0,
                 can_go_back: false,
                 can_go_forward: false
@@ -385,9 +385,9 @@ extension WebViewWrapper: WKNavigationDelegate {
         Task { @MainActor in
             let event = CWaterUI.WuiWebViewEvent(
                 event_type: WuiWebViewEventType_Error,
-                url: WuiStr(string: "").intoInner(),
-                url2: WuiStr(string: "").intoInner(),
-                message: WuiStr(string: error.localizedDescription).intoInner(),
+                url: WuiStr.raw(""),
+                url2: WuiStr.raw(""),
+                message: WuiStr.raw(error.localizedDescription),
                 progress: 0,
                 can_go_back: false,
                 can_go_forward: false
@@ -284,6 +284,8 @@ private func registerBuiltinComponentsIfNeeded() {
         /// The resolved inner component - never nil after initialization
         private let inner: any WuiComponent
         private var lastAutoLayoutWidth: CGFloat = 0
+        /// Auto Layout queries the intrinsic size repeatedly between content changes.
+        private let intrinsicMemo = IntrinsicSizeMemo()
 
         public var stretchAxis: WuiStretchAxis {
             inner.stretchAxis
@@ -321,19 +323,37 @@ private func registerBuiltinComponentsIfNeeded() {
         /// Returns intrinsic content size for UIKit Auto Layout integration.
         /// This allows WaterUI views to participate in Auto Layout constraints.
         override public var intrinsicContentSize: CGSize {
-            var intrinsic = sizeThatFits(WuiProposalSize())
-
             // When the host constrains our width via Auto Layout, keep the natural (content) width
             // but recompute height using the current width so multiline content can wrap correctly.
+            // Both sizes are memoized until the content changes.
+            let measure = { [inner] (proposal: WuiProposalSize) in inner.sizeThatFits(proposal) }
             guard !translatesAutoresizingMaskIntoConstraints, bounds.width > 0 else {
-                return applyStretchAxisToIntrinsicSize(intrinsic)
+                return applyStretchAxisToIntrinsicSize(intrinsicMemo.naturalSize(measure))
             }
 
-            let constrained = sizeThatFits(WuiProposalSize(width: Float(bounds.width), height: nil))
-            intrinsic.height = constrained.height
+            var intrinsic = intrinsicMemo.naturalSize(measure)
+            intrinsic.height = intrinsicMemo.size(forWidth: bounds.width, measure).height
             return applyStretchAxisToIntrinsicSize(intrinsic)
         }
 
+        override public func invalidateIntrinsicContentSize() {
+            super.invalidateIntrinsicContentSize()
+            intrinsicMemo.invalidate()
+        }
+
+        /// Dynamic Type, bold text and display scale change text metrics without any
+        /// content change reaching `invalidateIntrinsicContentSize`.
+        override public func traitCollectionDidChange(_ previousTraitCollection: UITraitCollection?) {
+            super.traitCollectionDidChange(previousTraitCollection)
+            guard let previous = previousTraitCollection else { return }
+            if traitCollection.preferredContentSizeCategory != previous.preferredContentSizeCategory
+                || traitCollection.legibilityWeight != previous.legibilityWeight
+                || traitCollection.displayScale != previous.displayScale
+            {
+                invalidateIntrinsicContentSize()
+            }
+        }
+
         override public func sizeThatFits(_ size: CGSize) -> CGSize {
             sizeThatFits(WuiProposalSize(size: size))
         }
@@ -454,6 +474,8 @@ private func registerBuiltinComponentsIfNeeded() {
         /// The resolved inner component - never nil after initialization
         private let inner: any WuiComponent
         private var lastAutoLayoutWidth: CGFloat = 0
+        /// Auto Layout queries the intrinsic size repeatedly between content changes.
+        private let intrinsicMemo = IntrinsicSizeMemo()
 
         public var stretchAxis: WuiStretchAxis {
             inner.stretchAxis
@@ -488,19 +510,31 @@ private func registerBuiltinComponentsIfNeeded() {
         /// Returns intrinsic content size for AppKit Auto Layout integration.
         /// This allows WaterUI views to participate in Auto Layout constraints.
         override public var intrinsicContentSize: NSSize {
-            var intrinsic = sizeThatFits(WuiProposalSize())
-
             // When the host constrains our width via Auto Layout, keep the natural (content) width
             // but recompute height using the current width so multiline content can wrap correctly.
+            // Both sizes are memoized until the content changes.
+            let measure = { [inner] (proposal: WuiProposalSize) in inner.sizeThatFits(proposal) }
             guard !translatesAutoresizingMaskIntoConstraints, bounds.width > 0 else {
-                return applyStretchAxisToIntrinsicSize(intrinsic)
+                return applyStretchAxisToIntrinsicSize(intrinsicMemo.naturalSize(measure))
             }
 
-            let constrained = sizeThatFits(WuiProposalSize(width: Float(bounds.width), height: nil))
-            intrinsic.height = constrained.height
+            var intrinsic = intrinsicMemo.naturalSize(measure)
+            intrinsic.height = intrinsicMemo.size(forWidth: bounds.width, measure).height
             return applyStretchAxisToIntrinsicSize(intrinsic)
         }
 
+        override public func invalidateIntrinsicContentSize() {
+            super.invalidateIntrinsicContentSize()
+            intrinsicMemo.invalidate()
+        }
+
+        /// Moving to a display with a different backing scale changes text metrics without
+        /// any content change reaching `invalidateIntrinsicContentSize`.
+        override public func viewDidChangeBackingProperties() {
+            super.viewDidChangeBackingProperties()
+            invalidateIntrinsicContentSize()
+        }
+
         override public var isFlipped: Bool { true }
 
         public func sizeThatFits(_ size: NSSize) -> NSSize {
@@ -611,3 +645,12 @@ private func registerBuiltinComponentsIfNeeded() {
         }
     }
 #endif
+
+// MARK: - Concurrent Measurement
+
+extension WuiAnyView: ConcurrentlyMeasurable {
+    /// Forwards to the resolved component when it can measure off the main thread.
+    var concurrentMeasure: ConcurrentMeasure? {
+        (inner as? ConcurrentlyMeasurable)?.concurrentMeasure
+    }
+}
@@ -6,6 +6,7 @@
 //
 
 import CWaterUI
+import Foundation
 
 // Helper class to store array information without generic parameters
 private final class ArrayInfo {
@@ -24,6 +25,10 @@ private final class ArrayInfo {
 
 final class WuiRawArray {
     private var inner: CWaterUI.WuiArray?
+    // Arrays are immutable once they cross the FFI, so their elements are looked up once.
+    private var pinned: WuiArraySlice?
+    /// Whether the elements back a value that may outlive this wrapper's use of them.
+    private(set) var isLent = false
 
     init(_ inner: CWaterUI.WuiArray) {
         self.inner = inner
@@ -32,10 +37,29 @@ final class WuiRawArray {
     func intoInner() -> CWaterUI.WuiArray {
         let v = inner!
         inner = nil
+        pinned = nil
         return v
     }
 
+    private static let inlineAlignment = Int(waterui_array_copy_alignment())
+
     init<T>(array: [T]) {
+        // Plain values are copied into a single native block, which avoids boxing an
+        // `ArrayInfo` and lets `elements()` skip the vtable.
+        //
+        // `_isPOD` is the standard library's own check for trivial types (no references,
+        // no non-trivial copy or destroy), the same one `Array` uses to decide it may
+        // memcpy its storage. For those a bitwise copy is a valid copy and freeing the block
+        // without running destructors leaks nothing. The check folds to a constant once
+        // `T` is specialized. Over-aligned types such as SIMD vectors take the boxed path,
+        // since the block only guarantees the alignment of its header.
+        if _isPOD(T.self) && MemoryLayout<T>.alignment <= Self.inlineAlignment {
+            self.inner = array.withUnsafeBufferPointer { buffer in
+                waterui_array_copy(buffer.baseAddress, UInt(buffer.count), UInt(MemoryLayout<T>.stride))
+            }
+            return
+        }
+
         let contiguousArray = ContiguousArray(array)
 
         // Simplified drop function
@@ -77,9 +101,46 @@ final class WuiRawArray {
         self.inner = innerArray
     }
 
+    private func elements() -> WuiArraySlice {
+        if let pinned {
+            return pinned
+        }
+        let slice = withUnsafePointer(to: inner!) { waterui_array_slice($0) }
+        pinned = slice
+        return slice
+    }
+
+    /// Marks the elements as borrowed by a value that keeps this wrapper alive.
+    func lend() {
+        isLent = true
+    }
+
+    /// Converts byte storage into a shared buffer in place and returns another handle to
+    /// it, so both sides can own the bytes without copying them.
+    func retainSharedBytes() -> CWaterUI.WuiArray_u8 {
+        var bytes = unsafeBitCast(inner!, to: CWaterUI.WuiArray_u8.self)
+        if !waterui_bytes_is_shared(&bytes) {
+            bytes = waterui_bytes_share(bytes)
+            inner = unsafeBitCast(bytes, to: CWaterUI.WuiArray.self)
+        }
+        return waterui_bytes_retain(&bytes)
+    }
+
+    /// Calls `body` with the underlying array.
+    func withUnsafeInner<R>(_ body: (UnsafePointer<CWaterUI.WuiArray>) throws -> R) rethrows -> R {
+        try withUnsafePointer(to: inner!, body)
+    }
+
+    /// Calls `body` with the elements in place, without copying them.
+    func withUnsafeBufferPointer<T, R>(_ body: (UnsafeBufferPointer<T>) throws -> R) rethrows -> R {
+        let slice = elements()
+        let typedHead = slice.head?.assumingMemoryBound(to: T.self)
+        return try body(UnsafeBufferPointer(start: typedHead, count: typedHead == nil ? 0 : Int(slice.len)))
+    }
+
     subscript<T>(index: Int) -> T {
         get {
-            let slice = (inner!.vtable.slice)(inner!.data)
+            let slice = elements()
             let head = slice.head!
             let len = Int(slice.len)
             precondition(index >= 0 && index < len, "Index out of bounds")
@@ -89,7 +150,7 @@ final class WuiRawArray {
         }
 
         set {
-            let slice = (inner!.vtable.slice)(inner!.data)
+            let slice = elements()
             let head = slice.head!
             let len = Int(slice.len)
             precondition(index >= 0 && index < len, "Index out of bounds")
@@ -100,15 +161,7 @@ final class WuiRawArray {
     }
 
     func toArray<T>() -> [T] {
-        let slice = (inner!.vtable.slice)(inner!.data)
-        let len = Int(slice.len)
-        guard len > 0, let head = slice.head else {
-            return []
-        }
-
-        let typedHead = head.assumingMemoryBound(to: T.self)
-        let buffer = UnsafeBufferPointer<T>(start: typedHead, count: len)
-        return Array(buffer)
+        withUnsafeBufferPointer { (buffer: UnsafeBufferPointer<T>) in Array(buffer) }
     }
 
     @MainActor deinit {
@@ -151,6 +204,10 @@ struct WuiArray<T> {
     func toArray() -> [T] {
         self.inner.toArray()
     }
+
+    func withUnsafeBufferPointer<R>(_ body: (UnsafeBufferPointer<T>) throws -> R) rethrows -> R {
+        try self.inner.withUnsafeBufferPointer(body)
+    }
 }
 
 extension WuiArray<UInt8> {
@@ -175,25 +232,118 @@ extension WuiArray<CWaterUI.WuiStyledChunk> {
     }
 }
 
+// Decoded interned strings by intern ID, so a repeated label is only converted once.
+// Only strings of at most `WuiStr.internLimit` bytes are interned, which bounds what the
+// cache can hold.
+private nonisolated(unsafe) let internedStrings: NSCache<NSNumber, NSString> = {
+    let cache = NSCache<NSNumber, NSString>()
+    cache.countLimit = 1024
+    return cache
+}()
+
 struct WuiStr {
     var inner: WuiArray<UInt8>
 
+    // Strings up to this many bytes fit in a Swift small string without allocating, so
+    // borrowing the buffer would not save anything.
+    private static let smallStringLimit = 15
+
+    // Labels and titles are short; longer text rarely repeats and would only pin memory in
+    // the intern table and the decode cache.
+    static let internLimit = 64
+
     init(_ inner: CWaterUI.WuiStr) {
         self.inner = WuiArray<UInt8>(inner._0)
     }
 
     init(string: String) {
-        let bytes = [UInt8](string.utf8)
-        self.inner = WuiArray<UInt8>(array: bytes)
+        self.inner = WuiArray<UInt8>(Self.raw(string)._0)
+    }
+
+    /// Creates an owned C string for handing straight to Rust.
+    ///
+    /// Unlike `WuiStr(string:).intoInner()`, this skips the Swift wrapper, so a short
+    /// string costs no allocation on either side: it lands in a recycled native cell.
+    static func raw(_ string: String) -> CWaterUI.WuiStr {
+        var string = string
+        return string.withUTF8 { bytes in
+            waterui_str_new(bytes.baseAddress, UInt(bytes.count))
+        }
     }
 
+    /// The intern ID of this string, or 0 if it is not an interned handle.
+    var internID: UInt64 {
+        inner.inner.withUnsafeInner { array in
+            array.withMemoryRebound(to: CWaterUI.WuiStr.self, capacity: 1) { waterui_str_intern_id($0) }
+        }
+    }
+
+    /// Returns a shared handle to this string from the native intern table.
+    ///
+    /// Equal strings share one handle, and `toString()` decodes each interned string once.
+    /// Strings longer than `internLimit` bytes are returned unchanged.
+    func interned() -> WuiStr {
+        if internID != 0 {
+            return self
+        }
+        return inner.withUnsafeBufferPointer { bytes in
+            guard bytes.count <= Self.internLimit else {
+                return self
+            }
+            return WuiStr(waterui_str_intern(bytes.baseAddress, UInt(bytes.count)))
+        }
+    }
+
+    /// Decodes the string.
+    ///
+    /// Interned strings are answered from a cache after the first call. Other strings that
+    /// are all ASCII and too long for a small string borrow the buffer instead of copying
+    /// it, and keep it alive for as long as the returned string needs it; Foundation keeps
+    /// ASCII bytes as they are, whereas anything else it would transcode into a copy.
+    /// Everything else is decoded with a single copy, replacing invalid sequences.
     func toString() -> String {
-        let bytes = inner.toArray()
-        return String(bytes: bytes, encoding: .utf8)!
+        let id = internID
+        guard id != 0, inner.withUnsafeBufferPointer({ $0.count }) <= Self.internLimit else {
+            return decode()
+        }
+        let key = NSNumber(value: id)
+        if let cached = internedStrings.object(forKey: key) {
+            return cached as String
+        }
+        let string = decode()
+        internedStrings.setObject(string as NSString, forKey: key)
+        return string
+    }
+
+    private func decode() -> String {
+        let owner = inner.inner
+        return owner.withUnsafeBufferPointer { (bytes: UnsafeBufferPointer<UInt8>) in
+            guard bytes.count > Self.smallStringLimit, let head = bytes.baseAddress,
+                waterui_utf8_is_ascii(head, UInt(bytes.count))
+            else {
+                return String(decoding: bytes, as: UTF8.self)
+            }
+            let borrowed = NSString(
+                bytesNoCopy: UnsafeMutableRawPointer(mutating: head),
+                length: bytes.count,
+                encoding: String.Encoding.ascii.rawValue,
+                deallocator: { _, _ in withExtendedLifetime(owner) {} }
+            )
+            guard let borrowed else {
+                return String(decoding: bytes, as: UTF8.self)
+            }
+            owner.lend()
+            return borrowed as String
+        }
     }
 
     func intoInner() -> CWaterUI.WuiStr {
-        unsafeBitCast(self.inner.intoInner(), to: CWaterUI.WuiStr.self)
+        // A lent buffer may still back a string returned by `toString()`, so Rust gets a
+        // shared handle to it instead.
+        if inner.inner.isLent {
+            return CWaterUI.WuiStr(_0: inner.inner.retainSharedBytes())
+        }
+        return unsafeBitCast(self.inner.intoInner(), to: CWaterUI.WuiStr.self)
     }
 
 }
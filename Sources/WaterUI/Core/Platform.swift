@@ -43,28 +43,88 @@ public typealias PlatformLayoutPriority = NSLayoutConstraint.Priority
 
 #endif
 
+// MARK: - Pixel Grid
+
+extension PlatformView {
+    /// Pixels per point of the display showing this view, or 0 while it is off-screen.
+    var pixelScale: CGFloat {
+        #if canImport(UIKit)
+        return window == nil ? 0 : traitCollection.displayScale
+        #elseif canImport(AppKit)
+        return window?.backingScaleFactor ?? 0
+        #endif
+    }
+}
+
 // MARK: - Layout Invalidation
 
+/// A container that mirrors itself in the native layout-node tree.
+/// Content changes below it are filtered here: they only keep travelling up the
+/// hierarchy when they change a measurement the container's layout depends on.
+@MainActor
+protocol LayoutNodeOwner: PlatformView {
+    /// The container's `WuiLayoutNode`.
+    var layoutNode: OpaquePointer { get }
+
+    /// Called when the content of `child`, a direct subview, changed.
+    /// Returns whether the container's own size may have changed as a result.
+    func childContentDidChange(_ child: PlatformView) -> Bool
+
+    /// Invalidates the container's own size after `childContentDidChange` reported a change.
+    /// That call already re-measured the changed child, so the other children keep their
+    /// cached measurements.
+    func invalidateForChildChange()
+}
+
+extension LayoutNodeOwner {
+    /// The node of the nearest container above this one, if any.
+    var ancestorLayoutNode: OpaquePointer? {
+        var parent = superview
+        while let p = parent {
+            if let owner = p as? LayoutNodeOwner {
+                return owner.layoutNode
+            }
+            parent = p.superview
+        }
+        return nil
+    }
+}
+
 extension PlatformView {
-    /// Invalidates layout for this view and all ancestor views.
-    /// Use when content size changes and the entire hierarchy needs re-layout.
+    /// Invalidates layout for this view and its ancestors.
+    /// Use when content size changes. Propagation stops at the first container whose
+    /// layout is unaffected by the change.
     func invalidateLayoutHierarchy() {
         #if canImport(UIKit)
         invalidateIntrinsicContentSize()
         setNeedsLayout()
+        var child: PlatformView = self
         var parent = superview
         while let p = parent {
-            p.invalidateIntrinsicContentSize()
+            if let owner = p as? LayoutNodeOwner {
+                guard owner.childContentDidChange(child) else { return }
+                owner.invalidateForChildChange()
+            } else {
+                p.invalidateIntrinsicContentSize()
+            }
             p.setNeedsLayout()
+            child = p
             parent = p.superview
         }
         #elseif canImport(AppKit)
         invalidateIntrinsicContentSize()
         needsLayout = true
+        var child: PlatformView = self
         var parent = superview
         while let p = parent {
-            p.invalidateIntrinsicContentSize()
+            if let owner = p as? LayoutNodeOwner {
+                guard owner.childContentDidChange(child) else { return }
+                owner.invalidateForChildChange()
+            } else {
+                p.invalidateIntrinsicContentSize()
+            }
             p.needsLayout = true
+            child = p
             parent = p.superview
         }
         #endif
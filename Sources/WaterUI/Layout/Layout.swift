@@ -108,6 +108,38 @@ struct WuiRect {
     }
 }
 
+extension WuiRect64 {
+    var cgRect: CGRect {
+        CGRect(x: CGFloat(x), y: CGFloat(y), width: CGFloat(width), height: CGFloat(height))
+    }
+}
+
+// MARK: - Frame Scratch
+
+/// Runs `body` with room for `count` values of the trivial type `T` taken from the calling
+/// thread's frame arena.
+///
+/// The memory is uninitialized and only valid inside `body`. It is released when the
+/// outermost open frame closes, so inside a layout pass it costs a pointer bump and
+/// nothing is freed until the pass ends. Falls back to the heap if the arena cannot
+/// serve the request.
+func withFrameScratch<T, R>(
+    of type: T.Type,
+    count: Int,
+    _ body: (UnsafeMutableBufferPointer<T>) throws -> R
+) rethrows -> R {
+    waterui_frame_arena_begin()
+    defer { waterui_frame_arena_end() }
+    let bytes = count * MemoryLayout<T>.stride
+    if let raw = waterui_frame_arena_alloc(UInt(bytes), UInt(MemoryLayout<T>.alignment)) {
+        let start = raw.bindMemory(to: T.self, capacity: count)
+        return try body(UnsafeMutableBufferPointer(start: start, count: count))
+    }
+    let heap = UnsafeMutableBufferPointer<T>.allocate(capacity: count)
+    defer { heap.deallocate() }
+    return try body(heap)
+}
+
 // MARK: - Layout Engine
 
 @MainActor
@@ -126,35 +158,150 @@ final class WuiLayout {
     /// The layout will call the measure closure multiple times with different proposals.
     func sizeThatFits(
         proposal: WuiProposalSize,
-        children: [SubViewProxy]
+        subviews: SubViewSet
     ) -> CGSize {
-        let subviews = children.map { $0.toWuiSubView() }
-        let array = WuiArray(array: subviews)
-        let typedArray = unsafeBitCast(
-            array.inner.intoInner(),
-            to: CWaterUI.WuiArray_WuiSubView.self
-        )
-        let size = waterui_layout_size_that_fits(inner, proposal.toCStruct(), typedArray)
+        let size = waterui_layout_container_size(inner, proposal.toCStruct(), subviews.inner)
         return WuiSize(size).cgSize
     }
 
     /// Place children within the given bounds.
-    /// Returns a rect for each child specifying its position and size.
+    /// Returns a rect for each child specifying its position and size, snapped to the
+    /// pixel grid of a display with `scale` pixels per point (0 leaves rects unsnapped).
     func place(
         bounds: CGRect,
-        children: [SubViewProxy]
+        subviews: SubViewSet,
+        scale: CGFloat = 0
     ) -> [CGRect] {
-        let subviews = children.map { $0.toWuiSubView() }
-        let array = WuiArray(array: subviews)
-        let typedArray = unsafeBitCast(
-            array.inner.intoInner(),
-            to: CWaterUI.WuiArray_WuiSubView.self
-        )
-        let boundsRaw = WuiRect(bounds).toCStruct()
-        let rects = waterui_layout_place(inner, boundsRaw, typedArray)
-        let rawArray = unsafeBitCast(rects, to: CWaterUI.WuiArray.self)
-        let bridged = WuiArray<CWaterUI.WuiRect>(c: rawArray)
-        return bridged.toArray().map { WuiRect($0).cgRect }
+        withPlacementScratch(for: subviews) { rects, snapped in
+            let produced = waterui_layout_place_into(
+                inner, WuiRect(bounds).toCStruct(), subviews.inner, rects.baseAddress, UInt(rects.count))
+            return snap(rects, count: min(Int(produced), rects.count), scale: scale, into: snapped)
+                .map(\.cgRect)
+        }
+    }
+
+    /// Size the layout for `proposal` and place children within `bounds` in one FFI call.
+    /// Measurements made while sizing are reused while placing. Rects are snapped as in
+    /// `place` and delivered to `apply` straight from frame-arena buffers, so the native
+    /// side allocates nothing in steady state. The Rust place call still returns an owned
+    /// rect array, which the driver copies out and drops, so each pass makes one Rust-side
+    /// allocation. Returns the container size and the number of rects.
+    @discardableResult
+    func sizeAndPlace(
+        proposal: WuiProposalSize,
+        bounds: CGRect,
+        subviews: SubViewSet,
+        scale: CGFloat = 0,
+        apply: (Int, CGRect) -> Void
+    ) -> (size: CGSize, count: Int) {
+        withPlacementScratch(for: subviews) { rects, snapped in
+            var produced: UInt = 0
+            let size = waterui_layout_size_and_place_into(
+                inner, proposal.toCStruct(), WuiRect(bounds).toCStruct(), subviews.inner,
+                rects.baseAddress, UInt(rects.count), &produced)
+
+            let placed = snap(rects, count: min(Int(produced), rects.count), scale: scale, into: snapped)
+            for index in placed.indices {
+                apply(index, placed[index].cgRect)
+            }
+            return (WuiSize(size).cgSize, placed.count)
+        }
+    }
+
+    /// Layouts produce one rect per child, so both placement buffers hold the child count:
+    /// the rects as produced by the layout, then widened and snapped to the pixel grid.
+    private func withPlacementScratch<R>(
+        for subviews: SubViewSet,
+        _ body: (UnsafeMutableBufferPointer<CWaterUI.WuiRect>, UnsafeMutableBufferPointer<WuiRect64>) -> R
+    ) -> R {
+        let count = subviews.count
+        return withFrameScratch(of: CWaterUI.WuiRect.self, count: count) { rects in
+            withFrameScratch(of: WuiRect64.self, count: count) { snapped in
+                body(rects, snapped)
+            }
+        }
+    }
+
+    /// Widens and snaps the first `count` of `rects` into `out` in one native pass.
+    private func snap(
+        _ rects: UnsafeMutableBufferPointer<CWaterUI.WuiRect>,
+        count: Int,
+        scale: CGFloat,
+        into out: UnsafeMutableBufferPointer<WuiRect64>
+    ) -> UnsafeMutableBufferPointer<WuiRect64> {
+        waterui_rects_snap(rects.baseAddress, UInt(count), Double(scale), out.baseAddress)
+        return UnsafeMutableBufferPointer(rebasing: out[..<count])
+    }
+}
+
+// MARK: - Layout Tracing
+
+/// Records every layout negotiation to a compact binary trace.
+/// Traces can be replayed offline, without Apple hardware, by `Tools/layout-replay`.
+@MainActor
+public enum LayoutTrace {
+    /// Start recording to the file at `path`. Returns false if a recording is already running
+    /// or the file cannot be created.
+    @discardableResult
+    public static func start(path: String) -> Bool {
+        waterui_layout_trace_start(path)
+    }
+
+    /// Stop recording and flush the trace file.
+    public static func stop() {
+        waterui_layout_trace_stop()
+    }
+
+    public static var isActive: Bool {
+        waterui_layout_trace_is_active()
+    }
+}
+
+/// Cost counters for layout negotiation, kept by the native layout driver.
+/// Cheap enough to leave on in production, e.g. to report layout storms.
+@MainActor
+public enum LayoutStats {
+    /// Counters accumulated since the last `reset()`.
+    public static var current: CWaterUI.WuiLayoutStats {
+        waterui_layout_stats()
+    }
+
+    public static func reset() {
+        waterui_layout_stats_reset()
+    }
+}
+
+// MARK: - Concurrent Measurement
+
+/// A measurement that reads no view state, so a measure pool may run it on a worker thread.
+typealias ConcurrentMeasure = @Sendable (WuiProposalSize) -> CGSize
+
+/// Leaf components whose measurement is a pure function of state they publish up front,
+/// such as text shaping. Containers flag these children thread-safe, and large sets
+/// measure them in parallel before the layout asks.
+@MainActor
+protocol ConcurrentlyMeasurable {
+    /// A measure that stays valid for the component's lifetime, or nil when the current
+    /// content must be measured on the main actor.
+    var concurrentMeasure: ConcurrentMeasure? { get }
+}
+
+/// The context of a thread-safe child's C subview. Unlike `SubViewProxy` it is not bound
+/// to the main actor, so a measure pool's workers can call into it.
+final class ConcurrentMeasureProxy: Sendable {
+    let measure: ConcurrentMeasure
+
+    init(_ measure: @escaping ConcurrentMeasure) {
+        self.measure = measure
+    }
+
+    static let measureEntry: WuiSubViewMeasureFn = { contextPtr, proposal in
+        guard let contextPtr = contextPtr else {
+            return CWaterUI.WuiSize(width: 0, height: 0)
+        }
+        let proxy = Unmanaged<ConcurrentMeasureProxy>.fromOpaque(contextPtr).takeUnretainedValue()
+        let size = proxy.measure(WuiProposalSize(proposal))
+        return CWaterUI.WuiSize(width: Float(size.width), height: Float(size.height))
     }
 }
 
@@ -170,6 +317,8 @@ final class SubViewProxy {
     let stretchAxis: WuiStretchAxis
     /// Layout priority (higher = measured first)
     let priority: Int32
+    /// Set for thread-safe children, whose C subview then measures through it.
+    let concurrent: ConcurrentMeasureProxy?
 
     init(
         stretchAxis: WuiStretchAxis = .none,
@@ -179,35 +328,246 @@ final class SubViewProxy {
         self.measure = measure
         self.stretchAxis = stretchAxis
         self.priority = priority
+        self.concurrent = nil
     }
 
-    func toWuiSubView() -> CWaterUI.WuiSubView {
-        // Create a retained reference to self for the callback
-        let context = Unmanaged.passRetained(self).toOpaque()
+    init(stretchAxis: WuiStretchAxis, priority: Int32, concurrentMeasure: @escaping ConcurrentMeasure) {
+        self.measure = concurrentMeasure
+        self.stretchAxis = stretchAxis
+        self.priority = priority
+        self.concurrent = ConcurrentMeasureProxy(concurrentMeasure)
+    }
 
-        let vtable = CWaterUI.WuiSubViewVTable(
-            measure: { contextPtr, proposal in
-                guard let contextPtr = contextPtr else {
-                    return CWaterUI.WuiSize(width: 0, height: 0)
-                }
-                let proxy = Unmanaged<SubViewProxy>.fromOpaque(contextPtr).takeUnretainedValue()
-                let swiftProposal = WuiProposalSize(proposal)
-                let size = proxy.measure(swiftProposal)
-                return CWaterUI.WuiSize(width: Float(size.width), height: Float(size.height))
-            },
-            drop: { contextPtr in
-                guard let contextPtr = contextPtr else { return }
-                Unmanaged<SubViewProxy>.fromOpaque(contextPtr).release()
-            }
-        )
+    /// The `WuiSubViewFlags` to hand over with `toBorrowedWuiSubView()`.
+    var flags: UInt32 {
+        concurrent != nil ? WuiSubViewFlags_ThreadSafe.rawValue : WuiSubViewFlags_None.rawValue
+    }
+
+    /// The batch entry matching `toBorrowedWuiSubView()`. Thread-safe children measure
+    /// one by one without touching the main actor, so they have none.
+    var batchVTable: UnsafePointer<CWaterUI.WuiSubViewBatchVTable>? {
+        concurrent != nil ? nil : Self.batchVTablePointer
+    }
 
+    /// A subview whose context is not retained.
+    /// Only valid while the caller keeps this proxy alive; never hand it to Rust.
+    func toBorrowedWuiSubView() -> CWaterUI.WuiSubView {
+        if let concurrent {
+            return CWaterUI.WuiSubView(
+                context: Unmanaged.passUnretained(concurrent).toOpaque(),
+                vtable: CWaterUI.WuiSubViewVTable(measure: ConcurrentMeasureProxy.measureEntry, drop: nil),
+                stretch_axis: stretchAxis.ffiValue,
+                priority: priority
+            )
+        }
         return CWaterUI.WuiSubView(
-            context: context,
-            vtable: vtable,
+            context: Unmanaged.passUnretained(self).toOpaque(),
+            vtable: CWaterUI.WuiSubViewVTable(measure: Self.measureEntry, drop: nil),
             stretch_axis: stretchAxis.ffiValue,
             priority: priority
         )
     }
+
+    // MARK: Callbacks
+
+    /// Per-child measure entry shared by every proxy, so batched dispatch can recognise them.
+    static let measureEntry: WuiSubViewMeasureFn = { contextPtr, proposal in
+        guard let contextPtr = contextPtr else {
+            return CWaterUI.WuiSize(width: 0, height: 0)
+        }
+        let proxy = Unmanaged<SubViewProxy>.fromOpaque(contextPtr).takeUnretainedValue()
+        let size = proxy.measure(WuiProposalSize(proposal))
+        return CWaterUI.WuiSize(width: Float(size.width), height: Float(size.height))
+    }
+
+    /// Measures a run of proxies in a single crossing from C.
+    static let measureManyEntry: WuiSubViewMeasureManyFn = { contexts, proposals, outSizes, n in
+        guard let contexts, let proposals, let outSizes else { return }
+        for i in 0..<Int(n) {
+            guard let contextPtr = contexts[i] else {
+                outSizes[i] = CWaterUI.WuiSize(width: 0, height: 0)
+                continue
+            }
+            let proxy = Unmanaged<SubViewProxy>.fromOpaque(contextPtr).takeUnretainedValue()
+            let size = proxy.measure(WuiProposalSize(proposals[i]))
+            outSizes[i] = CWaterUI.WuiSize(width: Float(size.width), height: Float(size.height))
+        }
+    }
+
+    /// Batch entry covering every borrowed subview produced by a `SubViewProxy`.
+    static var batchVTable: CWaterUI.WuiSubViewBatchVTable {
+        CWaterUI.WuiSubViewBatchVTable(measure: measureEntry, measure_many: measureManyEntry)
+    }
+
+    /// Stable storage for `batchVTable`, used by the measure caches to forward misses.
+    static let batchVTablePointer: UnsafePointer<CWaterUI.WuiSubViewBatchVTable> = {
+        let pointer = UnsafeMutablePointer<CWaterUI.WuiSubViewBatchVTable>.allocate(capacity: 1)
+        pointer.initialize(to: batchVTable)
+        return UnsafePointer(pointer)
+    }()
+
+    /// Hit/miss counters accumulated by every measure cache.
+    static var cacheStats: CWaterUI.WuiMeasureCacheStats {
+        waterui_measure_cache_global_stats()
+    }
+}
+
+// MARK: - SubView Set
+
+/// A container's persistent set of child subviews, backed by a C-owned `WuiSubViews`.
+/// Entries are patched only when the child at an index changes, so proxies and their
+/// cached measurements survive across layout passes.
+@MainActor
+final class SubViewSet {
+    let inner: OpaquePointer
+    /// Keeps proxies alive: the C entries borrow them.
+    private var proxies: [SubViewProxy] = []
+    private var identities: [ObjectIdentifier] = []
+    /// Whether the set measures its thread-safe children on the shared pool.
+    private var usesMeasurePool = false
+
+    /// Below this many children, waking the pool costs more than it saves.
+    private static let measurePoolThreshold = 64
+
+    init() {
+        self.inner = waterui_subviews_new(0)!
+    }
+
+    @MainActor deinit {
+        waterui_subviews_drop(inner)
+    }
+
+    var count: Int {
+        proxies.count
+    }
+
+    /// Borrowed array view for the layout functions. Valid until the next `sync`.
+    var array: CWaterUI.WuiArray_WuiSubView {
+        waterui_subviews_array(inner)
+    }
+
+    /// Bring the set in line with `children`, rebuilding only entries whose child,
+    /// stretch axis or priority changed. On a measure pool, children that are
+    /// `ConcurrentlyMeasurable` measure through their concurrent measure instead of
+    /// `measureChild`.
+    func sync<V: WuiComponent>(
+        children: [V],
+        measureChild: @escaping (V, WuiProposalSize) -> CGSize
+    ) {
+        sync(
+            count: children.count,
+            identity: { ObjectIdentifier(children[$0]) },
+            traits: { (children[$0].stretchAxis, children[$0].layoutPriority()) },
+            makeMeasure: { index in
+                let child = children[index]
+                return { proposal in measureChild(child, proposal) }
+            },
+            concurrentMeasure: { (children[$0] as? ConcurrentlyMeasurable)?.concurrentMeasure }
+        )
+    }
+
+    /// Bring the set in line with `count` children described by index.
+    /// `makeMeasure` and `concurrentMeasure` are only called for entries that must be
+    /// rebuilt: those whose identity, stretch axis or priority changed, or all of them when
+    /// the set starts or stops using the measure pool. While it uses the pool, an entry
+    /// with a concurrent measure is flagged thread-safe and measures through it.
+    func sync(
+        count: Int,
+        identity: (Int) -> ObjectIdentifier,
+        traits: (Int) -> (stretchAxis: WuiStretchAxis, priority: Int32),
+        makeMeasure: (Int) -> (WuiProposalSize) -> CGSize,
+        concurrentMeasure: (Int) -> ConcurrentMeasure? = { _ in nil }
+    ) {
+        if count < proxies.count {
+            proxies.removeLast(proxies.count - count)
+            identities.removeLast(identities.count - count)
+        }
+        waterui_subviews_resize(inner, UInt(count))
+
+        // Concurrent measures only pay off on a pool; switching rebuilds every entry.
+        let wantsMeasurePool = count >= Self.measurePoolThreshold
+        let poolChanged = wantsMeasurePool != usesMeasurePool
+        if poolChanged {
+            usesMeasurePool = wantsMeasurePool
+            waterui_subviews_set_measure_pool(inner, wantsMeasurePool ? NativeLayoutBridge.measurePool : nil)
+        }
+
+        for index in 0..<count {
+            let id = identity(index)
+            let (stretchAxis, priority) = traits(index)
+
+            if !poolChanged, index < proxies.count, identities[index] == id,
+                proxies[index].stretchAxis == stretchAxis, proxies[index].priority == priority
+            {
+                continue
+            }
+
+            let proxy: SubViewProxy
+            if wantsMeasurePool, let concurrent = concurrentMeasure(index) {
+                proxy = SubViewProxy(stretchAxis: stretchAxis, priority: priority, concurrentMeasure: concurrent)
+            } else {
+                proxy = SubViewProxy(stretchAxis: stretchAxis, priority: priority, measure: makeMeasure(index))
+            }
+            if index < proxies.count {
+                proxies[index] = proxy
+                identities[index] = id
+            } else {
+                proxies.append(proxy)
+                identities.append(id)
+            }
+            waterui_subviews_update(
+                inner, UInt(index), proxy.toBorrowedWuiSubView(), proxy.batchVTable, proxy.flags)
+        }
+    }
+
+    /// Forget every cached measurement, e.g. after a child's content changed.
+    func invalidate() {
+        waterui_subviews_invalidate(inner)
+    }
+
+    /// Report that the child at `index` changed its content.
+    /// Re-measures it with last pass's proposals and marks `node` dirty only if a size changed.
+    /// Only that child's cache is refreshed; its siblings keep their measurements.
+    /// Returns whether the change affects the owning container's layout.
+    func childDidChange(at index: Int, node: OpaquePointer) -> Bool {
+        waterui_layout_node_child_changed(node, waterui_subviews_cache(inner, UInt(index)))
+    }
+}
+
+// MARK: - Intrinsic Size Memo
+
+/// A view's natural size and its size at one constrained width, kept until `invalidate()`.
+/// Auto Layout asks for the intrinsic size repeatedly between content changes, and those
+/// are the only two proposals it needs.
+@MainActor
+final class IntrinsicSizeMemo {
+    private var natural: CGSize?
+    private var constrained: (width: CGFloat, size: CGSize)?
+
+    /// The size for an unspecified proposal.
+    func naturalSize(_ measure: (WuiProposalSize) -> CGSize) -> CGSize {
+        if let natural {
+            return natural
+        }
+        let size = measure(WuiProposalSize())
+        natural = size
+        return size
+    }
+
+    /// The size for a proposal of `width` and an unspecified height.
+    func size(forWidth width: CGFloat, _ measure: (WuiProposalSize) -> CGSize) -> CGSize {
+        if let constrained, constrained.width == width {
+            return constrained.size
+        }
+        let size = measure(WuiProposalSize(width: Float(width), height: nil))
+        constrained = (width, size)
+        return size
+    }
+
+    func invalidate() {
+        natural = nil
+        constrained = nil
+    }
 }
 
 // MARK: - CGFloat Extensions
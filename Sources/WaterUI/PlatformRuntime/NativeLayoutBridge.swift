@@ -1,23 +1,28 @@
+import CWaterUI
 import CoreGraphics
+import Foundation
 
 /// Shared helper that drives measurements and placement using the Rust layout FFI.
 /// Uses the SubView callback protocol - Rust calls back to Swift to measure children.
 @MainActor
 struct NativeLayoutBridge {
-    /// Creates SubViewProxy instances for each child view.
+    /// Worker threads shared by every subview set large enough to measure its thread-safe
+    /// children in parallel. Started on first use and kept for the life of the process;
+    /// nil on single-core devices, where the main thread measures alone.
+    static let measurePool: OpaquePointer? = {
+        let workers = min(ProcessInfo.processInfo.activeProcessorCount - 1, 7)
+        guard workers > 0 else { return nil }
+        return waterui_measure_pool_new(UInt32(workers))
+    }()
+
+    /// Brings the container's persistent subview set in line with its children.
     /// The measure closure will be called by Rust during layout.
-    func createSubViewProxies<V: WuiComponent>(
+    func syncSubViews<V: WuiComponent>(
+        _ subviews: SubViewSet,
         children: [V],
         measureChild: @escaping (V, WuiProposalSize) -> CGSize
-    ) -> [SubViewProxy] {
-        children.map { child in
-            SubViewProxy(
-                stretchAxis: child.stretchAxis,
-                priority: child.layoutPriority()
-            ) { proposal in
-                measureChild(child, proposal)
-            }
-        }
+    ) {
+        subviews.sync(children: children, measureChild: measureChild)
     }
 
     /// Calculate the container size using Rust layout engine.
@@ -25,18 +30,35 @@ struct NativeLayoutBridge {
     func containerSize(
         layout: WuiLayout,
         parentProposal: WuiProposalSize,
-        children: [SubViewProxy]
+        subviews: SubViewSet
     ) -> CGSize {
-        layout.sizeThatFits(proposal: parentProposal, children: children)
+        layout.sizeThatFits(proposal: parentProposal, subviews: subviews)
     }
 
-    /// Get placement rects for all children.
+    /// Get placement rects for all children, snapped to the pixel grid at `scale`.
     /// Rust will call back to measure each child as needed during placement.
     func placements(
         layout: WuiLayout,
         bounds: CGRect,
-        children: [SubViewProxy]
+        subviews: SubViewSet,
+        scale: CGFloat = 0
     ) -> [CGRect] {
-        layout.place(bounds: bounds, children: children)
+        layout.place(bounds: bounds, subviews: subviews, scale: scale)
+    }
+
+    /// Size the container with `proposal` and place its children within `bounds`.
+    /// Runs both negotiation steps in a single FFI call and hands each rect, snapped to
+    /// the pixel grid at `scale`, to `apply` without building an intermediate array.
+    @discardableResult
+    func sizeAndPlace(
+        layout: WuiLayout,
+        proposal: WuiProposalSize,
+        bounds: CGRect,
+        subviews: SubViewSet,
+        scale: CGFloat = 0,
+        apply: (Int, CGRect) -> Void
+    ) -> (size: CGSize, count: Int) {
+        layout.sizeAndPlace(
+            proposal: proposal, bounds: bounds, subviews: subviews, scale: scale, apply: apply)
     }
 }
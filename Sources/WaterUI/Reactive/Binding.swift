@@ -22,7 +22,10 @@ final class WuiBinding<T> {
     var value: T {
         didSet {
             guard !isSyncingFromRust else { return }
+            // One edit can ripple through many dependents; their watchers see it once.
+            waterui_begin_batch()
             setFn(inner, value)
+            waterui_commit_batch()
         }
     }
 
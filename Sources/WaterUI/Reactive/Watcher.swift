@@ -6,6 +6,7 @@
 //
 
 import CWaterUI
+import Foundation
 
 @MainActor
 class WatcherGuard {
@@ -18,28 +19,29 @@ class WatcherGuard {
     }
 }
 
-@MainActor
-class WuiWatcherMetadata {
-    var inner: OpaquePointer
+/// Metadata for one watcher notification, read out of Rust and dropped on arrival so that
+/// delivering a value allocates nothing.
+struct WuiWatcherMetadata {
+    let info: CWaterUI.WuiWatcherInfo
+
     init(_ inner: OpaquePointer) {
-        self.inner = inner
+        self.info = waterui_watcher_metadata_take(inner)
     }
 
     func getAnimation() -> CWaterUI.WuiAnimation {
-        waterui_get_animation(inner)
+        info.animation
     }
 
     var animation: Animation? {
-        let parsed = parseAnimation(getAnimation())
+        guard info.flags & WuiWatcherFlags_Animated.rawValue != 0 else {
+            return nil
+        }
+        let parsed = parseAnimation(info.animation)
         if case .none = parsed {
             return nil
         }
         return parsed
     }
-
-    @MainActor deinit {
-        waterui_drop_watcher_metadata(inner)
-    }
 }
 
 // MARK: - Watcher Implementations
@@ -47,7 +49,7 @@ class WuiWatcherMetadata {
 // Pattern for implementing Watcher protocol for C-level watcher types:
 //
 // For value types (Int32, Bool, Double, etc.):
-//   1. Create a Wrapper class to hold the Swift closure
+//   1. Hold the Swift closure with `wrap`, which files it in the native slot table
 //   2. Create C-style call function with matching parameter type
 //   3. Create C-style drop function
 //   4. Pass data, call, and drop to the C struct initializer
@@ -57,27 +59,144 @@ class WuiWatcherMetadata {
 //   2. Use (UnsafeRawPointer?, OpaquePointer?, OpaquePointer?) for call signature
 //   3. Convert OpaquePointer to Swift type in the call function
 
-final class Wrapper<T> {
-    let inner: (T, WuiWatcherMetadata) -> Void
-    init(_ inner: @escaping (T, WuiWatcherMetadata) -> Void) { self.inner = inner }
+/// Watcher closures, stored by slot index next to the native slot table that hands out
+/// their handles. Closures are kept as they are, with no box around them, and each entry
+/// remembers the handle it was filed under. Handles carry the slot's generation, so a
+/// lookup is an array read and a handle comparison, with no call into the table.
+@MainActor
+enum WatcherSlab {
+    /// Storage type for closures. An entry is only ever cast back to the closure type it
+    /// was stored as, which `callWrapper` and `wrap` agree on through `T`.
+    private typealias Erased = () -> Void
+
+    private struct Entry {
+        let handle: WuiSlotHandle
+        let closure: Erased
+    }
+
+    private static var entries: ContiguousArray<Entry?> = []
+    private static let indexMask: WuiSlotHandle = (1 << WUI_SLOT_INDEX_BITS) - 1
+
+    static func insert<T>(_ closure: @escaping (T, WuiWatcherMetadata) -> Void) -> WuiSlotHandle {
+        let handle = waterui_slot_insert()
+        precondition(handle != 0, "Watcher slot table exhausted")
+        let index = Int(handle & indexMask)
+        while entries.count <= index {
+            entries.append(nil)
+        }
+        entries[index] = Entry(handle: handle, closure: unsafeBitCast(closure, to: Erased.self))
+        return handle
+    }
 
+    /// The closure behind `handle`, or nil once its watcher has been dropped.
+    static func closure<T>(for handle: WuiSlotHandle, as _: T.Type) -> ((T, WuiWatcherMetadata) -> Void)? {
+        let index = Int(handle & indexMask)
+        guard index < entries.count, let entry = entries[index], entry.handle == handle else {
+            return nil
+        }
+        return unsafeBitCast(entry.closure, to: ((T, WuiWatcherMetadata) -> Void).self)
+    }
+
+    static func remove(_ handle: WuiSlotHandle) {
+        let index = waterui_slot_remove(handle)
+        guard index >= 0 else {
+            return
+        }
+        entries[Int(index)] = nil
+    }
 }
 
+/// A watcher notification held back by an open batch (see `waterui_begin_batch`).
+@MainActor
+final class DeferredDelivery {
+    /// Delivers the value, or returns false if the watcher is gone by then.
+    let deliver: () -> Bool
+    /// Releases the held value if the notification is superseded or its watcher is gone.
+    let discard: (() -> Void)?
+    private var delivered = false
+
+    init(_ deliver: @escaping () -> Bool, discard: (() -> Void)?) {
+        self.deliver = deliver
+        self.discard = discard
+    }
+
+    static let call: @convention(c) (UnsafeMutableRawPointer?) -> Void = { context in
+        MainActor.assumeIsolated {
+            let delivery = Unmanaged<DeferredDelivery>.fromOpaque(context!).takeUnretainedValue()
+            delivery.delivered = delivery.deliver()
+        }
+    }
+
+    static let drop: @convention(c) (UnsafeMutableRawPointer?) -> Void = { context in
+        MainActor.assumeIsolated {
+            let delivery = Unmanaged<DeferredDelivery>.fromOpaque(context!).takeRetainedValue()
+            if !delivery.delivered {
+                delivery.discard?()
+            }
+        }
+    }
+}
+
+/// Delivers a notification to the watcher behind `data`. While a batch is open it waits
+/// for the commit instead, and only the watcher's latest value is delivered. Owned values
+/// pass `discard` so that the copies a later value supersedes are released.
 @MainActor
 func callWrapper<T>(
-    _ data: UnsafeMutableRawPointer?, _ value: T, _ metadata: OpaquePointer?
+    _ data: UnsafeMutableRawPointer?, _ value: T, _ metadata: OpaquePointer?,
+    discard: ((T) -> Void)? = nil
 ) {
-    let wrapper = Unmanaged<Wrapper<T>>.fromOpaque(data!).takeUnretainedValue()
-    wrapper.inner(value, WuiWatcherMetadata(metadata!))
+    let metadata = WuiWatcherMetadata(metadata!)
+    let handle = WuiSlotHandle(UInt(bitPattern: data))
+    // A stale handle means the watcher was dropped already; there is no one to notify.
+    guard let closure = WatcherSlab.closure(for: handle, as: T.self) else {
+        discard?(value)
+        return
+    }
+    if waterui_batch_is_open() {
+        let discardValue: (() -> Void)? = discard.map { discard in { discard(value) } }
+        // The watcher may be dropped before the batch commits, so the handle is resolved
+        // again at delivery rather than keeping the closure alive.
+        let deliver = { () -> Bool in
+            guard let closure = WatcherSlab.closure(for: handle, as: T.self) else {
+                return false
+            }
+            closure(value, metadata)
+            return true
+        }
+        let delivery = Unmanaged.passRetained(DeferredDelivery(deliver, discard: discardValue))
+        let call = WuiDeferredCall(
+            key: UnsafeRawPointer(data),
+            context: delivery.toOpaque(),
+            call: DeferredDelivery.call,
+            drop: DeferredDelivery.drop
+        )
+        if waterui_batch_defer(call) {
+            return
+        }
+        delivery.release()
+    }
+    closure(value, metadata)
 }
 
+/// Removes the watcher behind `data`. The slot table is main-thread only, so a watcher
+/// dropped elsewhere is removed on the main queue.
 func dropWrapper<T>(_ data: UnsafeMutableRawPointer?, _: T.Type) {
-    _ = Unmanaged<Wrapper<T>>.fromOpaque(data!).takeRetainedValue()
+    let handle = WuiSlotHandle(UInt(bitPattern: data))
+    if Thread.isMainThread {
+        MainActor.assumeIsolated { WatcherSlab.remove(handle) }
+    } else {
+        DispatchQueue.main.async {
+            MainActor.assumeIsolated { WatcherSlab.remove(handle) }
+        }
+    }
 }
 
+/// Stores `f` in the watcher slab and returns its slot handle as the watcher context, so
+/// Rust never holds a raw pointer to a Swift object.
+@MainActor
 func wrap<T>(_ f: @escaping (T, WuiWatcherMetadata) -> Void) -> UnsafeMutableRawPointer {
-    let wrapper = Wrapper(f)
-    return UnsafeMutableRawPointer(Unmanaged.passRetained(wrapper).toOpaque())
+    let handle = WatcherSlab.insert(f)
+    return UnsafeMutableRawPointer(bitPattern: handle)!
 }
 
 @MainActor
@@ -294,7 +413,8 @@ func makePickerItemsWatcher(_ f: @escaping (CWaterUI.WuiArray_WuiPickerItem, Wui
     let data = wrap(f)
     let call: @convention(c) (UnsafeMutableRawPointer?, CWaterUI.WuiArray_WuiPickerItem, OpaquePointer?) -> Void = {
         data, value, metadata in
-        callWrapper(data, value, metadata)
+        // The items are owned; a superseded array is dropped through its vtable.
+        callWrapper(data, value, metadata, discard: { $0.vtable.drop($0.data) })
     }
     let drop: @convention(c) (UnsafeMutableRawPointer?) -> Void = {
         dropWrapper($0, CWaterUI.WuiArray_WuiPickerItem.self)
@@ -312,7 +432,8 @@ func makeColorWatcher(_ f: @escaping (OpaquePointer, WuiWatcherMetadata) -> Void
     let call: @convention(c) (UnsafeMutableRawPointer?, OpaquePointer?, OpaquePointer?) -> Void = {
         data, value, metadata in
         guard let value = value else { return }
-        callWrapper(data, value, metadata)
+        // The color is owned; a superseded one is dropped.
+        callWrapper(data, value, metadata, discard: { waterui_drop_color($0) })
     }
     let drop: @convention(c) (UnsafeMutableRawPointer?) -> Void = {
         dropWrapper($0, OpaquePointer.self)
@@ -10,9 +10,8 @@ struct WuiStyledStr {
     var chunks: [WuiStyledChunk]
 
     init(_ inner: CWaterUI.WuiStyledStr) {
-        self.chunks = []
-        for chunk in WuiArray(inner.chunks).toArray() {
-            chunks.append(WuiStyledChunk(chunk))
+        self.chunks = WuiArray(inner.chunks).withUnsafeBufferPointer { buffer in
+            buffer.map { WuiStyledChunk($0) }
         }
     }
 
@@ -34,7 +33,9 @@ struct WuiStyledChunk {
     var text: WuiStr
     var style: WuiTextStyle
     init(_ inner: CWaterUI.WuiStyledChunk) {
-        self.text = WuiStr(inner.text)
+        // Chunk text is mostly labels and titles that repeat across rows and updates;
+        // `interned()` leaves anything longer than a label on the ordinary path.
+        self.text = WuiStr(inner.text).interned()
         self.style = WuiTextStyle(inner.style)
     }
 
@@ -0,0 +1,111 @@
+/*
+ * Benchmark for `waterui_array_copy` and `waterui_array_slice` against the boxed arrays
+ * the Swift side built before.
+ *
+ * Builds on any host with a C11 compiler:
+ *
+ *     cc -std=c11 -O2 -I Sources/CWaterUI/include \
+ *         Tools/benchmarks/array-copy.c Sources/CWaterUI/Array.c \
+ *         -o wui-bench-array-copy
+ *
+ * The boxed stand-in mirrors `WuiRawArray.init(array:)` without the native block: the
+ * elements are copied into their own buffer (the ContiguousArray), a second allocation
+ * holds the bookkeeping (the ArrayInfo box), and every read goes through `vtable.slice`.
+ * Each iteration builds an array of rects, reads every element, and drops it.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "waterui_array.h"
+
+typedef struct Box {
+  void *elements;
+  uintptr_t len;
+} Box;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static struct WuiArraySlice box_slice(const void *data) {
+  const Box *box = data;
+  struct WuiArraySlice slice = {box->elements, box->len};
+  return slice;
+}
+
+static void box_drop(void *data) {
+  Box *box = data;
+  free(box->elements);
+  free(box);
+}
+
+static struct WuiArray box_copy(const void *elements, uintptr_t len, uintptr_t element_size) {
+  Box *box = malloc(sizeof(Box));
+  void *copy = malloc(len * element_size);
+  if (box == NULL || copy == NULL) {
+    abort();
+  }
+  memcpy(copy, elements, len * element_size);
+  box->elements = copy;
+  box->len = len;
+  struct WuiArray array = {box, {box_drop, box_slice}};
+  return array;
+}
+
+// Reads every element with one slice lookup per element, as the Swift subscript did.
+static float read_all(const struct WuiArray *array, uintptr_t len, int direct) {
+  float sum = 0;
+  for (uintptr_t i = 0; i < len; i++) {
+    struct WuiArraySlice slice = direct ? waterui_array_slice(array) : array->vtable.slice(array->data);
+    sum += ((const struct WuiRect *)slice.head)[i].size.width;
+  }
+  return sum;
+}
+
+static uint64_t run(int direct, const struct WuiRect *rects, uintptr_t len, int iterations, volatile float *sink) {
+  uint64_t start = now_ns();
+  for (int it = 0; it < iterations; it++) {
+    struct WuiArray array = direct ? waterui_array_copy(rects, len, sizeof(struct WuiRect))
+                                   : box_copy(rects, len, sizeof(struct WuiRect));
+    *sink += read_all(&array, len, direct);
+    array.vtable.drop(array.data);
+  }
+  return now_ns() - start;
+}
+
+int main(int argc, char **argv) {
+  uintptr_t len = argc > 1 ? (uintptr_t)strtoul(argv[1], NULL, 10) : 16;
+  int iterations = argc > 2 ? atoi(argv[2]) : 1000000;
+  if (len == 0 || iterations < 1) {
+    fprintf(stderr, "usage: %s [elements] [iterations]\n", argv[0]);
+    return 2;
+  }
+
+  struct WuiRect *rects = malloc(len * sizeof(struct WuiRect));
+  if (rects == NULL) {
+    return 1;
+  }
+  for (uintptr_t i = 0; i < len; i++) {
+    struct WuiRect rect = {{0, (float)i * 20}, {320, 20}};
+    rects[i] = rect;
+  }
+
+  volatile float sink = 0;
+  uint64_t boxed_ns = run(0, rects, len, iterations, &sink);
+  uint64_t inline_ns = run(1, rects, len, iterations, &sink);
+
+  printf("elements:  %lu x %d iterations\n", (unsigned long)len, iterations);
+  printf("boxed:     %8.3f ms  2 allocations/array\n", (double)boxed_ns / 1e6);
+  printf("inline:    %8.3f ms  1 allocation/array\n", (double)inline_ns / 1e6);
+  printf("speedup:   %.2fx\n", inline_ns > 0 ? (double)boxed_ns / (double)inline_ns : 0.0);
+
+  free(rects);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Benchmark for `WuiLayoutTree` over a 100k-node hierarchy.
+ *
+ * Builds on any host with a C11 compiler, with a stand-in for the Rust layouts:
+ *
+ *     cc -std=c11 -O2 -I Sources/CWaterUI/include -I Tools/common \
+ *         Tools/benchmarks/layout-tree.c Tools/common/stub_layout.c \
+ *         Sources/CWaterUI/LayoutTree.c Sources/CWaterUI/LayoutStats.c \
+ *         Sources/CWaterUI/LayoutTrace.c -lm -o wui-bench-layout-tree
+ *
+ * The tree is a root stack of sections, each a stack of leaves. The benchmark times
+ * building the tree, the first full compute, a compute with nothing changed, a compute
+ * after one leaf changed, and a compute after the root was resized.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "stub_layout.h"
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static struct WuiSize leaf_measure(void *context, struct WuiProposalSize proposal) {
+  struct WuiSize size = {proposal.width < 200 ? proposal.width : 200, (float)(12 + (uintptr_t)context % 5)};
+  return size;
+}
+
+static void leaf_drop(void *context) {
+  (void)context;
+}
+
+static void report(const char *name, uint64_t elapsed_ns, uint64_t layout_calls) {
+  struct WuiLayoutStats stats = waterui_layout_stats();
+  printf("%-16s %9.3f ms  %7llu layout calls  %8llu measures\n", name, (double)elapsed_ns / 1e6,
+         (unsigned long long)layout_calls, (unsigned long long)stats.measure_callbacks);
+  waterui_layout_stats_reset();
+}
+
+int main(int argc, char **argv) {
+  uint32_t sections = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000;
+  uint32_t leaves = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 99;
+  if (sections == 0) {
+    fprintf(stderr, "usage: %s [sections] [leaves-per-section]\n", argv[0]);
+    return 2;
+  }
+
+  waterui_layout_stats_reset();
+  uint64_t start = now_ns();
+  struct WuiLayoutTree *tree = waterui_layout_tree_new(1);
+  uint32_t root = waterui_layout_tree_add_root(tree);
+  waterui_layout_tree_set_layout(tree, root, stub_layout());
+  uint32_t first_section = waterui_layout_tree_add_children(tree, root, sections);
+  if (first_section == WUI_LAYOUT_TREE_NONE) {
+    fprintf(stderr, "error: cannot build the tree\n");
+    return 1;
+  }
+  for (uint32_t s = 0; s < sections; s++) {
+    uint32_t section = first_section + s;
+    waterui_layout_tree_set_layout(tree, section, stub_layout());
+    uint32_t first_leaf = waterui_layout_tree_add_children(tree, section, leaves);
+    for (uint32_t l = 0; l < leaves; l++) {
+      struct WuiSubView leaf = {(void *)(uintptr_t)(first_leaf + l), {leaf_measure, leaf_drop}, WuiStretchAxis_None, 0};
+      waterui_layout_tree_set_leaf(tree, first_leaf + l, leaf);
+    }
+  }
+  printf("nodes: %u (%u sections x %u leaves)\n", waterui_layout_tree_len(tree), sections, leaves);
+  report("build", now_ns() - start, 0);
+
+  struct WuiRect frame = {{0, 0}, {390, 844}};
+  uint64_t calls = stub_layout_calls();
+  start = now_ns();
+  waterui_layout_tree_compute(tree, frame);
+  report("first compute", now_ns() - start, stub_layout_calls() - calls);
+
+  calls = stub_layout_calls();
+  start = now_ns();
+  waterui_layout_tree_compute(tree, frame);
+  report("unchanged", now_ns() - start, stub_layout_calls() - calls);
+
+  // The last leaf of the middle section changed its content.
+  uint32_t changed = waterui_layout_tree_len(tree) / 2;
+  waterui_layout_tree_mark_dirty(tree, changed);
+  calls = stub_layout_calls();
+  start = now_ns();
+  waterui_layout_tree_compute(tree, frame);
+  report("one leaf dirty", now_ns() - start, stub_layout_calls() - calls);
+
+  frame.size.width = 430;
+  calls = stub_layout_calls();
+  start = now_ns();
+  waterui_layout_tree_compute(tree, frame);
+  report("root resized", now_ns() - start, stub_layout_calls() - calls);
+
+  waterui_layout_tree_drop(tree);
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Benchmark for `waterui_subviews_measure_uniform` against per-child measure calls.
+ *
+ * Builds on any host with a C11 compiler:
+ *
+ *     cc -std=c11 -O2 -I Sources/CWaterUI/include \
+ *         Tools/benchmarks/measure-many.c Sources/CWaterUI/SubView.c \
+ *         -o wui-bench-measure-many
+ *
+ * Each simulated backend crossing pays a fixed cost standing in for the Swift bridge
+ * (actor hop, retain/release, thunk), so the numbers show how much of a measure pass
+ * the batched entry saves as the per-crossing cost grows relative to the measure itself.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "waterui_subview.h"
+
+static uint64_t crossings;
+static volatile unsigned crossing_sink;
+static unsigned crossing_cost = 200;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void cross(void) {
+  crossings++;
+  for (unsigned i = 0; i < crossing_cost; i++) {
+    crossing_sink += i;
+  }
+}
+
+static struct WuiSize leaf_size(void *context, struct WuiProposalSize proposal) {
+  uintptr_t index = (uintptr_t)context;
+  struct WuiSize size = {proposal.width < 100 ? proposal.width : 100, (float)(10 + index % 7)};
+  return size;
+}
+
+static struct WuiSize leaf_measure(void *context, struct WuiProposalSize proposal) {
+  cross();
+  return leaf_size(context, proposal);
+}
+
+static void leaf_measure_many(void *const *contexts,
+                              const struct WuiProposalSize *proposals,
+                              struct WuiSize *out_sizes,
+                              uintptr_t n) {
+  cross();
+  for (uintptr_t i = 0; i < n; i++) {
+    out_sizes[i] = leaf_size(contexts[i], proposals[i]);
+  }
+}
+
+static void leaf_drop(void *context) {
+  (void)context;
+}
+
+static const struct WuiSubViewBatchVTable leaf_batch = {leaf_measure, leaf_measure_many};
+
+int main(int argc, char **argv) {
+  uintptr_t count = argc > 1 ? (uintptr_t)strtoul(argv[1], NULL, 10) : 10000;
+  int iterations = argc > 2 ? atoi(argv[2]) : 100;
+  if (argc > 3) {
+    crossing_cost = (unsigned)strtoul(argv[3], NULL, 10);
+  }
+  if (count == 0 || iterations < 1) {
+    fprintf(stderr, "usage: %s [children] [iterations] [crossing-cost]\n", argv[0]);
+    return 2;
+  }
+
+  struct WuiSubView *children = malloc(count * sizeof(struct WuiSubView));
+  struct WuiSize *sizes = malloc(count * sizeof(struct WuiSize));
+  if (children == NULL || sizes == NULL) {
+    return 1;
+  }
+  for (uintptr_t i = 0; i < count; i++) {
+    children[i].context = (void *)i;
+    children[i].vtable.measure = leaf_measure;
+    children[i].vtable.drop = leaf_drop;
+    children[i].stretch_axis = WuiStretchAxis_None;
+    children[i].priority = 0;
+  }
+  struct WuiProposalSize proposal = {320, 0.0f / 0.0f};
+
+  crossings = 0;
+  uint64_t start = now_ns();
+  for (int it = 0; it < iterations; it++) {
+    for (uintptr_t i = 0; i < count; i++) {
+      sizes[i] = children[i].vtable.measure(children[i].context, proposal);
+    }
+  }
+  uint64_t single_ns = now_ns() - start;
+  uint64_t single_crossings = crossings;
+
+  crossings = 0;
+  start = now_ns();
+  for (int it = 0; it < iterations; it++) {
+    waterui_subviews_measure_uniform(children, count, proposal, sizes, &leaf_batch);
+  }
+  uint64_t batched_ns = now_ns() - start;
+  uint64_t batched_crossings = crossings;
+
+  printf("children:  %lu x %d iterations, crossing cost %u\n", (unsigned long)count, iterations, crossing_cost);
+  printf("single:    %8.3f ms  %10llu crossings\n", (double)single_ns / 1e6, (unsigned long long)single_crossings);
+  printf("batched:   %8.3f ms  %10llu crossings\n", (double)batched_ns / 1e6, (unsigned long long)batched_crossings);
+  printf("speedup:   %.2fx\n", batched_ns > 0 ? (double)single_ns / (double)batched_ns : 0.0);
+
+  free(children);
+  free(sizes);
+  return 0;
+}
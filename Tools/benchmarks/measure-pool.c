@@ -0,0 +1,105 @@
+/*
+ * Worker-scaling benchmark for `WuiMeasurePool`.
+ *
+ * Builds on any host with a C11 compiler and pthreads, with a stand-in for the Rust
+ * layouts:
+ *
+ *     cc -std=c11 -O2 -pthread -I Sources/CWaterUI/include -I Tools/common \
+ *         Tools/benchmarks/measure-pool.c Tools/common/stub_layout.c \
+ *         Sources/CWaterUI/Layout.c Sources/CWaterUI/LayoutStats.c \
+ *         Sources/CWaterUI/LayoutTrace.c Sources/CWaterUI/SubViews.c \
+ *         Sources/CWaterUI/MeasureCache.c Sources/CWaterUI/MeasurePool.c \
+ *         Sources/CWaterUI/FrameArena.c -lm -o wui-bench-measure-pool
+ *
+ * A container of thread-safe children, each measure costing a fixed amount of work like
+ * text shaping, is invalidated and sized repeatedly with pools of growing size. Zero
+ * workers is the serial baseline: the calling thread prefetches alone.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stub_layout.h"
+
+static unsigned measure_cost = 2000;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static struct WuiSize shaped_measure(void *context, struct WuiProposalSize proposal) {
+  // Stands in for shaping a line of text: pure, but not free.
+  volatile unsigned sink = 0;
+  for (unsigned i = 0; i < measure_cost; i++) {
+    sink += i;
+  }
+  struct WuiSize size = {proposal.width < 200 ? proposal.width : 200, (float)(14 + (uintptr_t)context % 3)};
+  return size;
+}
+
+static void leaf_drop(void *context) {
+  (void)context;
+}
+
+static uint64_t run(struct WuiSubViews *subviews, int iterations) {
+  struct WuiProposalSize proposal = {320, 0.0f / 0.0f};
+  // One pass first, so the caches remember the proposals the layout asks.
+  waterui_layout_container_size(stub_layout(), proposal, subviews);
+  uint64_t start = now_ns();
+  for (int it = 0; it < iterations; it++) {
+    waterui_subviews_invalidate(subviews);
+    waterui_layout_container_size(stub_layout(), proposal, subviews);
+  }
+  return now_ns() - start;
+}
+
+int main(int argc, char **argv) {
+  uintptr_t count = argc > 1 ? (uintptr_t)strtoul(argv[1], NULL, 10) : 10000;
+  int iterations = argc > 2 ? atoi(argv[2]) : 20;
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  uint32_t max_workers = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : (uint32_t)(cores > 1 ? cores - 1 : 0);
+  if (argc > 4) {
+    measure_cost = (unsigned)strtoul(argv[4], NULL, 10);
+  }
+  if (count == 0 || iterations < 1) {
+    fprintf(stderr, "usage: %s [children] [iterations] [max-workers] [measure-cost]\n", argv[0]);
+    return 2;
+  }
+
+  struct WuiSubViews *subviews = waterui_subviews_new(count);
+  waterui_subviews_resize(subviews, count);
+  for (uintptr_t i = 0; i < count; i++) {
+    struct WuiSubView child = {(void *)i, {shaped_measure, leaf_drop}, WuiStretchAxis_None, 0};
+    waterui_subviews_update(subviews, i, child, NULL, WuiSubViewFlags_ThreadSafe);
+  }
+
+  printf("children: %lu x %d passes, measure cost %u\n", (unsigned long)count, iterations, measure_cost);
+  uint64_t baseline = 0;
+  for (uint32_t workers = 0;; workers = workers == 0 ? 1 : workers * 2) {
+    if (workers > max_workers) {
+      workers = max_workers;
+    }
+    struct WuiMeasurePool *pool = waterui_measure_pool_new(workers);
+    waterui_subviews_set_measure_pool(subviews, pool);
+    uint64_t elapsed = run(subviews, iterations);
+    waterui_subviews_set_measure_pool(subviews, NULL);
+    waterui_measure_pool_drop(pool);
+    if (workers == 0) {
+      baseline = elapsed;
+    }
+    printf("workers %2u: %8.3f ms/pass  %5.2fx\n", workers, (double)elapsed / 1e6 / iterations,
+           elapsed > 0 ? (double)baseline / (double)elapsed : 0.0);
+    if (workers >= max_workers) {
+      break;
+    }
+  }
+
+  waterui_subviews_drop(subviews);
+  return 0;
+}
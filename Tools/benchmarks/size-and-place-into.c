@@ -0,0 +1,112 @@
+/*
+ * Allocation benchmark for `waterui_layout_size_and_place_into` against
+ * `waterui_layout_size_and_place`.
+ *
+ * Builds on any host with a C11 compiler, with a stand-in for the Rust layouts:
+ *
+ *     cc -std=c11 -O2 -pthread -I Sources/CWaterUI/include -I Tools/common \
+ *         Tools/benchmarks/size-and-place-into.c Tools/common/stub_layout.c \
+ *         Sources/CWaterUI/Layout.c Sources/CWaterUI/LayoutStats.c \
+ *         Sources/CWaterUI/LayoutTrace.c Sources/CWaterUI/SubViews.c \
+ *         Sources/CWaterUI/MeasureCache.c Sources/CWaterUI/MeasurePool.c \
+ *         Sources/CWaterUI/FrameArena.c -lm -o wui-bench-size-and-place-into
+ *
+ * Both variants lay out the same set repeatedly. The owned-array variant copies the rects
+ * into a fresh buffer per pass, as the platform layer did when it built an array of
+ * frames; the `_into` variant writes into one buffer kept across passes. The stand-in
+ * allocates its rect array the way the Rust side does, which both variants pay; the
+ * driver counts those under layout allocations. Caller allocations are counted by the
+ * benchmark's own allocation wrapper.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "stub_layout.h"
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t caller_allocations;
+
+static void *counted_malloc(size_t size) {
+  caller_allocations++;
+  void *pointer = malloc(size);
+  if (pointer == NULL) {
+    abort();
+  }
+  return pointer;
+}
+
+static struct WuiSize leaf_measure(void *context, struct WuiProposalSize proposal) {
+  (void)proposal;
+  struct WuiSize size = {100, (float)(10 + (uintptr_t)context % 7)};
+  return size;
+}
+
+static void leaf_drop(void *context) {
+  (void)context;
+}
+
+static void report(const char *name, uint64_t elapsed_ns, int iterations) {
+  struct WuiLayoutStats stats = waterui_layout_stats();
+  printf("%-22s %8.3f ms  %5.2f layout + %5.2f caller allocations/pass  (%llu passes)\n", name,
+         (double)elapsed_ns / 1e6, (double)stats.allocations / iterations,
+         (double)caller_allocations / iterations, (unsigned long long)stats.passes);
+}
+
+int main(int argc, char **argv) {
+  uintptr_t count = argc > 1 ? (uintptr_t)strtoul(argv[1], NULL, 10) : 32;
+  int iterations = argc > 2 ? atoi(argv[2]) : 100000;
+  if (count == 0 || iterations < 1) {
+    fprintf(stderr, "usage: %s [children] [iterations]\n", argv[0]);
+    return 2;
+  }
+
+  struct WuiSubViews *subviews = waterui_subviews_new(count);
+  waterui_subviews_resize(subviews, count);
+  for (uintptr_t i = 0; i < count; i++) {
+    struct WuiSubView child = {(void *)i, {leaf_measure, leaf_drop}, WuiStretchAxis_None, 0};
+    waterui_subviews_update(subviews, i, child, NULL, WuiSubViewFlags_None);
+  }
+  struct WuiProposalSize proposal = {320, 480};
+  struct WuiRect bounds = {{0, 0}, {320, 480}};
+
+  printf("children: %lu x %d iterations\n", (unsigned long)count, iterations);
+
+  waterui_layout_stats_reset();
+  caller_allocations = 0;
+  uint64_t start = now_ns();
+  for (int it = 0; it < iterations; it++) {
+    struct WuiArray_WuiRect array;
+    waterui_layout_size_and_place(stub_layout(), proposal, bounds, subviews, &array);
+    struct WuiArraySlice_WuiRect slice = array.vtable.slice(array.data);
+    struct WuiRect *frames = counted_malloc(slice.len * sizeof(struct WuiRect));
+    for (uintptr_t i = 0; i < slice.len; i++) {
+      frames[i] = slice.head[i];
+    }
+    array.vtable.drop(array.data);
+    free(frames);
+  }
+  report("size_and_place", now_ns() - start, iterations);
+
+  waterui_layout_stats_reset();
+  caller_allocations = 0;
+  start = now_ns();
+  struct WuiRect *rects = counted_malloc(count * sizeof(struct WuiRect));
+  for (int it = 0; it < iterations; it++) {
+    uintptr_t len = 0;
+    waterui_layout_size_and_place_into(stub_layout(), proposal, bounds, subviews, rects, count, &len);
+  }
+  report("size_and_place_into", now_ns() - start, iterations);
+
+  free(rects);
+  waterui_subviews_drop(subviews);
+  return 0;
+}
@@ -0,0 +1,76 @@
+// Vertical-stack stand-in for the Rust layouts. See stub_layout.h.
+
+#include "stub_layout.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+static uint64_t calls;
+
+struct WuiLayout *stub_layout(void) {
+  static char handle;
+  return (struct WuiLayout *)(void *)&handle;
+}
+
+uint64_t stub_layout_calls(void) {
+  return calls;
+}
+
+struct WuiSize waterui_layout_size_that_fits(struct WuiLayout *layout,
+                                             struct WuiProposalSize proposal,
+                                             struct WuiArray_WuiSubView children) {
+  (void)layout;
+  calls++;
+  struct WuiArraySlice_WuiSubView slice = children.vtable.slice(children.data);
+  struct WuiProposalSize child_proposal = {proposal.width, NAN};
+  struct WuiSize size = {0, 0};
+  for (uintptr_t i = 0; i < slice.len; i++) {
+    struct WuiSubView *child = &slice.head[i];
+    struct WuiSize child_size = child->vtable.measure(child->context, child_proposal);
+    size.width = child_size.width > size.width ? child_size.width : size.width;
+    size.height += child_size.height;
+  }
+  return size;
+}
+
+static void rects_drop(void *data) {
+  free(data);
+}
+
+static struct WuiArraySlice_WuiRect rects_slice(const void *data) {
+  const uintptr_t *header = data;
+  struct WuiArraySlice_WuiRect slice;
+  slice.len = header[0];
+  slice.head = (struct WuiRect *)(void *)(header + 2);
+  return slice;
+}
+
+struct WuiArray_WuiRect waterui_layout_place(struct WuiLayout *layout,
+                                             struct WuiRect bounds,
+                                             struct WuiArray_WuiSubView children) {
+  (void)layout;
+  calls++;
+  struct WuiArraySlice_WuiSubView slice = children.vtable.slice(children.data);
+  // Two words of header keep the rects 16-byte aligned after the length.
+  uintptr_t *header = malloc(2 * sizeof(uintptr_t) + slice.len * sizeof(struct WuiRect));
+  if (header == NULL) {
+    abort();
+  }
+  header[0] = slice.len;
+  struct WuiRect *rects = (struct WuiRect *)(void *)(header + 2);
+  struct WuiProposalSize child_proposal = {bounds.size.width, NAN};
+  float y = bounds.origin.y;
+  for (uintptr_t i = 0; i < slice.len; i++) {
+    struct WuiSubView *child = &slice.head[i];
+    struct WuiSize child_size = child->vtable.measure(child->context, child_proposal);
+    rects[i].origin.x = bounds.origin.x;
+    rects[i].origin.y = y;
+    rects[i].size = child_size;
+    y += child_size.height;
+  }
+  struct WuiArray_WuiRect array;
+  array.data = header;
+  array.vtable.drop = rects_drop;
+  array.vtable.slice = rects_slice;
+  return array;
+}
@@ -0,0 +1,28 @@
+/*
+ * Host stand-in for the Rust layout entry points, shared by the programs under Tools/.
+ *
+ * Linking stub_layout.c satisfies `waterui_layout_size_that_fits` and
+ * `waterui_layout_place` with a plain vertical stack, so the native layout driver can be
+ * exercised without the Rust library. The stack measures every child once per call with
+ * the offered width and an unspecified height, like a `VStack` without spacing.
+ */
+
+#ifndef WATERUI_TOOLS_STUB_LAYOUT_H
+#define WATERUI_TOOLS_STUB_LAYOUT_H
+
+#include <stdint.h>
+
+#include "CWaterUI.h"
+
+/**
+ * Returns the layout handle the stub answers for. Any non-NULL pointer works; this one
+ * just reads better at call sites.
+ */
+struct WuiLayout *stub_layout(void);
+
+/**
+ * Number of Rust-side layout calls the stub has answered since start-up.
+ */
+uint64_t stub_layout_calls(void);
+
+#endif /* WATERUI_TOOLS_STUB_LAYOUT_H */
@@ -0,0 +1,38 @@
+/*
+ * Compile-time checks for include/waterui.hpp.
+ *
+ * Nothing is linked or run; the checks hold if this compiles with any C++17 compiler:
+ *
+ *     c++ -std=c++17 -fsyntax-only -Wall -Wextra -I Sources/CWaterUI/include \
+ *         Tools/cpp-check/main.cpp
+ *
+ * The header itself stays free of them so that every C++ translation unit that includes
+ * it does not pay for the instantiations.
+ */
+
+#include <type_traits>
+
+#include "waterui.hpp"
+
+namespace {
+
+// The wrappers must stay as cheap as the raw handles they replace.
+static_assert(sizeof(wui::owned<WuiEnv, waterui_drop_env>) == sizeof(WuiEnv *));
+static_assert(std::is_nothrow_move_constructible_v<wui::env> && std::is_nothrow_move_assignable_v<wui::env>);
+static_assert(!std::is_copy_constructible_v<wui::env> && !std::is_copy_assignable_v<wui::env>);
+static_assert(std::is_trivially_copyable_v<wui::array_view<WuiRect>>);
+static_assert(sizeof(wui::array_view<WuiRect>) == 2 * sizeof(void *));
+static_assert(std::is_same_v<wui::array_element_t<WuiArray_WuiRect>, WuiRect>);
+static_assert(std::is_same_v<wui::array_element_t<WuiArray_u8>, uint8_t>);
+static_assert(std::is_nothrow_move_constructible_v<wui::owned_array<WuiArray_u8>>);
+static_assert(!std::is_copy_constructible_v<wui::owned_array<WuiArray_u8>>);
+
+// Deduction from an array picks its element type.
+static_assert(std::is_same_v<decltype(wui::array_view(std::declval<const WuiArray_WuiRect &>())),
+                             wui::array_view<WuiRect>>);
+
+}  // namespace
+
+int main() {
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * Offline replayer for layout traces recorded with `waterui_layout_trace_start`.
+ *
+ * Builds on any host with a C11 compiler, no Apple SDK required:
+ *
+ *     cc -std=c11 -O2 -I Sources/CWaterUI/include -I Tools/common \
+ *         Tools/layout-replay/main.c Tools/common/stub_layout.c \
+ *         Sources/CWaterUI/LayoutTraceReplay.c Sources/CWaterUI/LayoutStats.c \
+ *         -ldl -o wui-layout-replay
+ *
+ * By default the replayer re-issues the recorded measurement stream against stand-in
+ * children and reports call counts and timings, which is enough to profile the native
+ * side and to catch malformed traces in CI. Two options run a real layout instead:
+ *
+ * - `--stack` answers every call with the vertical stack from Tools/common, which checks
+ *   the replay plumbing end to end and times the stand-ins under a real negotiation.
+ * - `--hook <library>` loads a shared library exporting `wui_replay_size_that_fits` and
+ *   `wui_replay_place` with the `WuiLayoutTraceReplayer` signatures, and an optional
+ *   `void *wui_replay_context(void)`. A build of the Rust layouts that maps recorded
+ *   layout ids back to layouts plugs in here, and `mismatched results` then reports
+ *   where it diverges from the recording. Ids are layout addresses and can be reused
+ *   within one trace, so such a mapping has to follow the trace in order.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stub_layout.h"
+#include "waterui_layout_trace.h"
+
+static uint8_t *read_file(const char *path, size_t *out_len) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+  size_t cap = 1 << 16;
+  size_t len = 0;
+  uint8_t *data = malloc(cap);
+  while (data != NULL) {
+    len += fread(data + len, 1, cap - len, file);
+    if (len < cap) {
+      break;
+    }
+    cap *= 2;
+    uint8_t *grown = realloc(data, cap);
+    if (grown == NULL) {
+      free(data);
+      data = NULL;
+    } else {
+      data = grown;
+    }
+  }
+  fclose(file);
+  *out_len = len;
+  return data;
+}
+
+static struct WuiSize stack_size_that_fits(void *context,
+                                           uint64_t layout_id,
+                                           struct WuiProposalSize proposal,
+                                           struct WuiArray_WuiSubView children) {
+  (void)context;
+  (void)layout_id;
+  return waterui_layout_size_that_fits(stub_layout(), proposal, children);
+}
+
+static struct WuiArray_WuiRect stack_place(void *context,
+                                           uint64_t layout_id,
+                                           struct WuiRect bounds,
+                                           struct WuiArray_WuiSubView children) {
+  (void)context;
+  (void)layout_id;
+  return waterui_layout_place(stub_layout(), bounds, children);
+}
+
+static bool load_hook(const char *path, WuiLayoutTraceReplayer *replayer) {
+  void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (library == NULL) {
+    fprintf(stderr, "error: %s\n", dlerror());
+    return false;
+  }
+  // The library stays loaded for the life of the process.
+  void *size_that_fits = dlsym(library, "wui_replay_size_that_fits");
+  void *place = dlsym(library, "wui_replay_place");
+  void *context = dlsym(library, "wui_replay_context");
+  if (size_that_fits == NULL && place == NULL) {
+    fprintf(stderr, "error: %s exports neither wui_replay_size_that_fits nor wui_replay_place\n", path);
+    return false;
+  }
+  // POSIX guarantees object and function pointers share a representation for dlsym.
+  memcpy(&replayer->size_that_fits, &size_that_fits, sizeof(size_that_fits));
+  memcpy(&replayer->place, &place, sizeof(place));
+  replayer->context = NULL;
+  if (context != NULL) {
+    void *(*make_context)(void);
+    memcpy(&make_context, &context, sizeof(context));
+    replayer->context = make_context();
+  }
+  return true;
+}
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [--stack | --hook <library>] <trace> [iterations]\n", program);
+}
+
+int main(int argc, char **argv) {
+  WuiLayoutTraceReplayer replayer = {0};
+  const WuiLayoutTraceReplayer *active = NULL;
+  int arg = 1;
+  if (arg < argc && strcmp(argv[arg], "--stack") == 0) {
+    replayer.size_that_fits = stack_size_that_fits;
+    replayer.place = stack_place;
+    active = &replayer;
+    arg++;
+  } else if (arg < argc && strcmp(argv[arg], "--hook") == 0) {
+    if (arg + 1 >= argc || !load_hook(argv[arg + 1], &replayer)) {
+      usage(argv[0]);
+      return 2;
+    }
+    active = &replayer;
+    arg += 2;
+  }
+  if (arg >= argc) {
+    usage(argv[0]);
+    return 2;
+  }
+  const char *path = argv[arg];
+  int iterations = arg + 1 < argc ? atoi(argv[arg + 1]) : 1;
+  if (iterations < 1) {
+    iterations = 1;
+  }
+
+  size_t len = 0;
+  uint8_t *data = read_file(path, &len);
+  if (data == NULL) {
+    fprintf(stderr, "error: cannot read %s\n", path);
+    return 1;
+  }
+
+  WuiLayoutTraceReplayStats total = {0};
+  bool ok = true;
+  for (int i = 0; i < iterations && ok; i++) {
+    WuiLayoutTraceReplayStats stats;
+    ok = waterui_layout_trace_replay(data, len, active, &stats);
+    total.size_calls += stats.size_calls;
+    total.place_calls += stats.place_calls;
+    total.measures += stats.measures;
+    total.unmatched_measures += stats.unmatched_measures;
+    total.mismatched_results += stats.mismatched_results;
+    total.elapsed_ns += stats.elapsed_ns;
+  }
+  free(data);
+
+  printf("iterations:         %d\n", iterations);
+  printf("size calls:         %llu\n", (unsigned long long)total.size_calls);
+  printf("place calls:        %llu\n", (unsigned long long)total.place_calls);
+  printf("measures:           %llu\n", (unsigned long long)total.measures);
+  printf("unmatched measures: %llu\n", (unsigned long long)total.unmatched_measures);
+  if (active != NULL) {
+    printf("mismatched results: %llu\n", (unsigned long long)total.mismatched_results);
+  }
+  printf("elapsed:            %.3f ms\n", (double)total.elapsed_ns / 1e6);
+
+  if (!ok) {
+    fprintf(stderr, "error: malformed trace\n");
+    return 1;
+  }
+  return total.unmatched_measures == 0 && total.mismatched_results == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*
+ * Checks for the frame arena in include/waterui_arena.h.
+ *
+ * Builds on any host with a C11 compiler:
+ *
+ *     cc -std=c11 -O2 -pthread -I Sources/CWaterUI/include \
+ *         Tools/tests/frame-arena.c Sources/CWaterUI/FrameArena.c -o wui-test-frame-arena
+ *
+ * Add -fsanitize=address to also check that a thread's blocks are released when it exits
+ * and that nothing is handed out twice.
+ *
+ * Exits non-zero and names each failing check.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "waterui_arena.h"
+
+static int failures;
+
+#define CHECK(condition)                                           \
+  do {                                                             \
+    if (!(condition)) {                                            \
+      printf("FAIL line %d: %s\n", __LINE__, #condition);          \
+      failures++;                                                  \
+    }                                                              \
+  } while (0)
+
+static void check_alignment(void) {
+  waterui_frame_arena_begin();
+  for (uintptr_t align = 1; align <= 4096; align *= 2) {
+    // An odd-sized allocation first, so every alignment has to skip padding.
+    unsigned char *odd = waterui_frame_arena_alloc(3, 1);
+    unsigned char *p = waterui_frame_arena_alloc(24, align);
+    CHECK(odd != NULL && p != NULL);
+    CHECK((uintptr_t)p % align == 0);
+    CHECK(p >= odd + 3);
+  }
+  CHECK(waterui_frame_arena_alloc(8, 0) == NULL);
+  CHECK(waterui_frame_arena_alloc(8, 24) == NULL);
+  CHECK(waterui_frame_arena_alloc(UINTPTR_MAX - 8, 8) == NULL);
+  waterui_frame_arena_end();
+}
+
+static void check_no_frame(void) {
+  CHECK(waterui_frame_arena_alloc(8, 8) == NULL);
+  // Unbalanced ends are ignored.
+  waterui_frame_arena_end();
+  CHECK(waterui_frame_arena_alloc(8, 8) == NULL);
+}
+
+#define OVERFLOW_COUNT 64
+#define OVERFLOW_SIZE (10 * 1024)
+
+static void check_overflow(void) {
+  // Far more than the first block, so the frame chains several blocks.
+  unsigned char *chunks[OVERFLOW_COUNT];
+  waterui_frame_arena_begin();
+  for (int i = 0; i < OVERFLOW_COUNT; i++) {
+    chunks[i] = waterui_frame_arena_alloc(OVERFLOW_SIZE, 16);
+    CHECK(chunks[i] != NULL);
+    if (chunks[i] != NULL) {
+      memset(chunks[i], i, OVERFLOW_SIZE);
+    }
+  }
+  // Growing must not move or overwrite earlier allocations.
+  for (int i = 0; i < OVERFLOW_COUNT; i++) {
+    if (chunks[i] != NULL) {
+      CHECK(chunks[i][0] == (unsigned char)i && chunks[i][OVERFLOW_SIZE - 1] == (unsigned char)i);
+    }
+  }
+  waterui_frame_arena_end();
+
+  // The next frame of the same size fits in the single merged block.
+  waterui_frame_arena_begin();
+  unsigned char *first = waterui_frame_arena_alloc(OVERFLOW_SIZE, 16);
+  unsigned char *last = first;
+  for (int i = 1; i < OVERFLOW_COUNT; i++) {
+    unsigned char *p = waterui_frame_arena_alloc(OVERFLOW_SIZE, 16);
+    CHECK(p == last + OVERFLOW_SIZE);
+    last = p;
+  }
+  waterui_frame_arena_end();
+
+  // Closing the frame rewinds the block.
+  waterui_frame_arena_begin();
+  CHECK(waterui_frame_arena_alloc(OVERFLOW_SIZE, 16) == first);
+  waterui_frame_arena_end();
+}
+
+static void check_nesting(void) {
+  waterui_frame_arena_begin();
+  unsigned char *outer = waterui_frame_arena_alloc(16, 8);
+  waterui_frame_arena_begin();
+  unsigned char *inner = waterui_frame_arena_alloc(16, 8);
+  waterui_frame_arena_end();
+  // Inner frames do not release anything; the next allocation follows the inner one.
+  unsigned char *after = waterui_frame_arena_alloc(16, 8);
+  CHECK(outer != NULL && inner == outer + 16 && after == inner + 16);
+  waterui_frame_arena_end();
+}
+
+static void *thread_main(void *out) {
+  waterui_frame_arena_begin();
+  void *p = waterui_frame_arena_alloc(1024, 8);
+  waterui_frame_arena_end();
+  *(void **)out = p;
+  return NULL;
+}
+
+static void check_threads(void) {
+  // Each thread gets its own arena, freed when the thread exits.
+  void *mine;
+  waterui_frame_arena_begin();
+  mine = waterui_frame_arena_alloc(1024, 8);
+  void *theirs = NULL;
+  pthread_t thread;
+  CHECK(pthread_create(&thread, NULL, thread_main, &theirs) == 0);
+  pthread_join(thread, NULL);
+  CHECK(mine != NULL && theirs != NULL && mine != theirs);
+  waterui_frame_arena_end();
+}
+
+int main(void) {
+  check_no_frame();
+  check_alignment();
+  check_overflow();
+  check_nesting();
+  check_threads();
+  if (failures != 0) {
+    printf("%d failure(s)\n", failures);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}
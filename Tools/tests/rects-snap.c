@@ -0,0 +1,76 @@
+/*
+ * Checks for `waterui_rects_snap`.
+ *
+ * Builds on any host with a C11 compiler. Build it twice to cover both the vector path
+ * of the host and the portable scalar path:
+ *
+ *     cc -std=c11 -O2 -I Sources/CWaterUI/include \
+ *         Tools/tests/rects-snap.c Sources/CWaterUI/Geometry.c -lm -o wui-test-rects-snap
+ *     cc -std=c11 -O2 -DWUI_SNAP_SCALAR -I Sources/CWaterUI/include \
+ *         Tools/tests/rects-snap.c Sources/CWaterUI/Geometry.c -lm -o wui-test-rects-snap-scalar
+ *
+ * Exits non-zero and names each failing case.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "waterui_geometry.h"
+
+static int failures;
+
+static struct WuiRect rect(float x, float y, float width, float height) {
+  struct WuiRect r = {{x, y}, {width, height}};
+  return r;
+}
+
+static int same(double actual, double expected) {
+  return (isnan(actual) && isnan(expected)) || actual == expected;
+}
+
+static void expect(const char *name, struct WuiRect input, double scale, double x, double y, double width,
+                   double height) {
+  struct WuiRect64 out;
+  waterui_rects_snap(&input, 1, scale, &out);
+  if (!same(out.x, x) || !same(out.y, y) || !same(out.width, width) || !same(out.height, height)) {
+    printf("FAIL %s: got {%g, %g, %g, %g}, expected {%g, %g, %g, %g}\n", name, out.x, out.y, out.width,
+           out.height, x, y, width, height);
+    failures++;
+  }
+}
+
+int main(void) {
+  // At 2x, a quarter point is half a pixel: ties go to the even pixel.
+  expect("tie rounds down to even", rect(0.25f, 0.25f, 1, 1), 2, 0, 0, 1, 1);
+  expect("tie rounds up to even", rect(0.75f, 0.75f, 1, 1), 2, 1, 1, 1, 1);
+  expect("far edge tie", rect(0, 0, 1.25f, 1.75f), 2, 0, 0, 1, 2);
+  expect("negative tie rounds to even", rect(-0.25f, -0.75f, 2, 2), 2, 0, -1, 2, 2);
+  expect("negative origin", rect(-3.4f, -10.6f, 5, 5), 1, -3, -11, 5, 5);
+  expect("negative origin at 3x", rect(-1.1f, -0.1f, 1, 1), 3, -1, 0, 1, 1);
+
+  // Neighbours derived from the same edge stay adjacent after snapping.
+  struct WuiRect row[2] = {rect(0, 0, 10.3f, 4), rect(10.3f, 0, 10.3f, 4)};
+  struct WuiRect64 snapped[2];
+  waterui_rects_snap(row, 2, 2, snapped);
+  if (snapped[0].x + snapped[0].width != snapped[1].x) {
+    printf("FAIL adjacent: %g + %g != %g\n", snapped[0].x, snapped[0].width, snapped[1].x);
+    failures++;
+  }
+
+  // Anything non-finite or out of range is widened as is.
+  expect("nan origin", rect(NAN, 1.3f, 2, 2), 2, NAN, 1.2999999523162842, 2, 2);
+  expect("nan size", rect(1.3f, 1.3f, NAN, 2), 2, 1.2999999523162842, 1.2999999523162842, NAN, 2);
+  expect("infinite size", rect(0.3f, 0, INFINITY, 2), 2, 0.30000001192092896, 0, INFINITY, 2);
+  expect("out of range", rect(1e9f, 0.3f, 1, 1), 2, 1e9, 0.30000001192092896, 1, 1);
+
+  // A scale that is not positive disables snapping.
+  expect("zero scale", rect(0.3f, 0.3f, 1, 1), 0, 0.30000001192092896, 0.30000001192092896, 1, 1);
+  expect("nan scale", rect(0.3f, 0.3f, 1, 1), NAN, 0.30000001192092896, 0.30000001192092896, 1, 1);
+
+  if (failures != 0) {
+    printf("%d failure(s)\n", failures);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}
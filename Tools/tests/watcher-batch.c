@@ -0,0 +1,199 @@
+/*
+ * Checks for the watcher batches in include/waterui_batch.h.
+ *
+ * Builds on any host with a C11 compiler:
+ *
+ *     cc -std=c11 -O2 -pthread -I Sources/CWaterUI/include \
+ *         Tools/tests/watcher-batch.c Sources/CWaterUI/WatcherBatch.c -o wui-test-watcher-batch
+ *
+ * Exits non-zero and names each failing check.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "waterui_batch.h"
+
+static int failures;
+
+#define CHECK(condition)                                           \
+  do {                                                             \
+    if (!(condition)) {                                            \
+      printf("FAIL line %d: %s\n", __LINE__, #condition);          \
+      failures++;                                                  \
+    }                                                              \
+  } while (0)
+
+// Every notification is a small record; deliveries and drops are logged as text so the
+// checks can compare whole sequences.
+typedef struct Note {
+  char name[8];
+  void (*during)(void);
+} Note;
+
+static char log_text[1024];
+static Note notes[64];
+static int note_count;
+
+static void append(const char *prefix, const char *name) {
+  strncat(log_text, prefix, sizeof(log_text) - strlen(log_text) - 1);
+  strncat(log_text, name, sizeof(log_text) - strlen(log_text) - 1);
+  strncat(log_text, " ", sizeof(log_text) - strlen(log_text) - 1);
+}
+
+static void note_call(void *context) {
+  Note *note = context;
+  append("+", note->name);
+  if (note->during != NULL) {
+    note->during();
+  }
+}
+
+static void note_drop(void *context) {
+  append("-", ((Note *)context)->name);
+}
+
+// Notifies the watcher `key` with `name`, delivering it on the spot if no batch holds it.
+static void notify(const void *key, const char *name, void (*during)(void)) {
+  Note *note = &notes[note_count++];
+  snprintf(note->name, sizeof(note->name), "%s", name);
+  note->during = during;
+  WuiDeferredCall call = {key, note, note_call, note_drop};
+  if (!waterui_batch_defer(call)) {
+    note_call(note);
+    note_drop(note);
+  }
+}
+
+static void reset(void) {
+  log_text[0] = '\0';
+  note_count = 0;
+}
+
+static const char watcher_a, watcher_b, watcher_c;
+
+static void check_unbatched(void) {
+  reset();
+  CHECK(!waterui_batch_is_open());
+  notify(&watcher_a, "a1", NULL);
+  CHECK(strcmp(log_text, "+a1 -a1 ") == 0);
+}
+
+static void check_coalescing_order(void) {
+  reset();
+  waterui_begin_batch();
+  CHECK(waterui_batch_is_open());
+  notify(&watcher_a, "a1", NULL);
+  notify(&watcher_b, "b1", NULL);
+  notify(&watcher_a, "a2", NULL);
+  notify(&watcher_c, "c1", NULL);
+  notify(&watcher_b, "b2", NULL);
+  // Superseded notifications are dropped undelivered as soon as they are replaced.
+  CHECK(strcmp(log_text, "-a1 -b1 ") == 0);
+  waterui_commit_batch();
+  // Latest values, in the order each watcher was first notified.
+  CHECK(strcmp(log_text, "-a1 -b1 +a2 -a2 +b2 -b2 +c1 -c1 ") == 0);
+  CHECK(!waterui_batch_is_open());
+}
+
+static void check_unkeyed(void) {
+  reset();
+  waterui_begin_batch();
+  notify(NULL, "x1", NULL);
+  notify(NULL, "x2", NULL);
+  waterui_commit_batch();
+  CHECK(strcmp(log_text, "+x1 -x1 +x2 -x2 ") == 0);
+}
+
+static void check_nesting(void) {
+  reset();
+  waterui_begin_batch();
+  notify(&watcher_a, "a1", NULL);
+  waterui_begin_batch();
+  notify(&watcher_a, "a2", NULL);
+  notify(&watcher_b, "b1", NULL);
+  waterui_commit_batch();
+  // Only the outermost commit delivers.
+  CHECK(waterui_batch_is_open());
+  CHECK(strcmp(log_text, "-a1 ") == 0);
+  waterui_commit_batch();
+  CHECK(strcmp(log_text, "-a1 +a2 -a2 +b1 -b1 ") == 0);
+
+  // Unbalanced commits are ignored.
+  waterui_commit_batch();
+  CHECK(!waterui_batch_is_open());
+}
+
+static void notify_b_now(void) {
+  notify(&watcher_b, "b2", NULL);
+}
+
+static void notify_b_batched(void) {
+  waterui_begin_batch();
+  notify(&watcher_b, "b3", NULL);
+  notify(&watcher_b, "b4", NULL);
+  waterui_commit_batch();
+}
+
+static void check_reentrant_delivery(void) {
+  // Deliveries run with the batch closed, so what they notify goes out right away.
+  reset();
+  waterui_begin_batch();
+  notify(&watcher_a, "a1", notify_b_now);
+  notify(&watcher_b, "b1", NULL);
+  waterui_commit_batch();
+  CHECK(strcmp(log_text, "+a1 +b2 -b2 -a1 +b1 -b1 ") == 0);
+
+  // A delivery that commits a batch of its own delivers just its own notifications.
+  reset();
+  waterui_begin_batch();
+  notify(&watcher_a, "a1", notify_b_batched);
+  notify(&watcher_c, "c1", NULL);
+  waterui_commit_batch();
+  CHECK(strcmp(log_text, "+a1 -b3 +b4 -b4 -a1 +c1 -c1 ") == 0);
+
+  // The batch state is usable again afterwards.
+  reset();
+  waterui_begin_batch();
+  notify(&watcher_a, "a5", NULL);
+  notify(&watcher_a, "a6", NULL);
+  waterui_commit_batch();
+  CHECK(strcmp(log_text, "-a5 +a6 -a6 ") == 0);
+}
+
+static void check_growth(void) {
+  // More distinct watchers than the initial capacity, each notified twice.
+  static char keys[48];
+  reset();
+  waterui_begin_batch();
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < 24; i++) {
+      char name[8];
+      snprintf(name, sizeof(name), "%c%d", 'A' + i, round);
+      notify(&keys[i], name, NULL);
+    }
+  }
+  waterui_commit_batch();
+  int delivered = 0;
+  for (const char *p = log_text; (p = strchr(p, '+')) != NULL; p++) {
+    delivered++;
+    CHECK(p[2] == '1');
+  }
+  CHECK(delivered == 24);
+  CHECK(strncmp(strchr(log_text, '+'), "+A1 ", 4) == 0);
+}
+
+int main(void) {
+  check_unbatched();
+  check_coalescing_order();
+  check_unkeyed();
+  check_nesting();
+  check_reentrant_delivery();
+  check_growth();
+  if (failures != 0) {
+    printf("%d failure(s)\n", failures);
+    return 1;
+  }
+  printf("ok\n");
+  return 0;
+}